@@ -0,0 +1,123 @@
+/*
+ * reflow.h
+ *
+ * In-process interface to the comment reformatter in reflow_comments.c, for editors and
+ * language servers that would otherwise run reformat_print on every save.
+ *
+ * reflow_buffer() applies Rules A-D to a Python source held in memory and returns the result
+ * in memory. The library keeps no global state and never writes to stdout, so any number of
+ * threads may call it at once. The Black workers that format Rule A snippets are the only
+ * state worth keeping between calls: start them once with reflow_black_start() and pass the
+ * handle in every call, so snippets are formatted without starting Python again and every
+ * result is remembered by snippet text.
+ *
+ * Build the library from the same source, with main() left out:
+ *   gcc -O2 -g -pthread -fPIC -fvisibility=hidden -DREFLOW_NO_MAIN -c -o reflow.o reflow_comments.c
+ *   ar rcs libreflow.a reflow.o
+ *   gcc -shared -pthread -o libreflow.so reflow.o
+ *
+ * Only the functions declared here are exported from libreflow.so.
+ */
+
+#ifndef REFLOW_H
+#define REFLOW_H
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+#define REFLOW_API __attribute__((visibility("default")))
+#else
+#define REFLOW_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* struct reflow_allocator
+ * Where the memory for a call's rule output and its result comes from. 'alloc' must return
+ * memory aligned like malloc()'s, or NULL on failure; 'release' takes back what 'alloc' gave.
+ * 'ctx' is passed to both.
+ */
+struct reflow_allocator {
+    void *(*alloc)(size_t size, void *ctx);
+    void (*release)(void *ptr, void *ctx);
+    void *ctx;
+};
+
+/* Rules, for reflow_opts.rules. */
+#define REFLOW_RULE_A 0x1u /* commented-out prints, formatted by Black */
+#define REFLOW_RULE_B 0x2u /* long inline comments */
+#define REFLOW_RULE_C 0x4u /* runs of full-line comments */
+#define REFLOW_RULE_D 0x8u /* standalone triple-quoted blocks */
+
+/* Line breaking, for reflow_opts.wrap. */
+#define REFLOW_WRAP_GREEDY  0 /* fill each line as far as it goes */
+#define REFLOW_WRAP_OPTIMAL 1 /* least ragged lines; rewrapping the result changes nothing */
+
+/* struct reflow_black
+ * Opaque handle to a pool of Black workers and the results they have already produced.
+ */
+struct reflow_black;
+
+/* struct reflow_opts
+ * Settings of one reflow_buffer() call. A zeroed struct is valid.
+ */
+struct reflow_opts {
+    struct reflow_black *black; /* formats Rule A snippets; NULL leaves commented prints alone */
+    const struct reflow_allocator *allocator; /* NULL: malloc() and free() */
+    int line_length;            /* 0: 79 */
+    unsigned rules;             /* REFLOW_RULE_* to apply; 0: all of them */
+    int wrap;                   /* REFLOW_WRAP_* for Rules C and D */
+};
+
+/* struct reflow_result
+ * Output of reflow_buffer(). 'text' is NUL-terminated ('len' excludes the terminator) and
+ * comes from the call's allocator; it is NULL when no block changed, so the caller can keep
+ * its buffer as it is.
+ */
+struct reflow_result {
+    char *text;
+    size_t len;
+    int changes; /* blocks rewritten */
+};
+
+/* reflow_black_start()
+ * Starts 'workers' Black helpers (at least one) formatting for the default line length of 79,
+ * run by the interpreter named in the "black" script's shebang or by $REFLOW_PYTHON; builds
+ * with REFLOW_EMBED_PYTHON use the embedded interpreter instead, and then allow only one
+ * handle at a time. Falls back to one "black" command per snippet when no helper can import
+ * Black. Returns NULL if Black is not available at all.
+ */
+REFLOW_API struct reflow_black *reflow_black_start(int workers);
+
+/* reflow_black_start_width()
+ * Like reflow_black_start(), but formats for 'line_length' (0: 79). The handle can only be
+ * used with reflow_opts of the same line length.
+ */
+REFLOW_API struct reflow_black *reflow_black_start_width(int workers, int line_length);
+
+/* reflow_black_stop()
+ * Finishes the queued snippets, stops the workers and frees the handle. NULL is ignored.
+ */
+REFLOW_API void reflow_black_stop(struct reflow_black *black);
+
+/* reflow_buffer()
+ * Reflows the 'len' bytes at 'in' as reformat_print would reflow a file with the same contents
+ * and fills in 'result'. 'opts' may be NULL. Returns 0 on success and -1 (with errno set, and
+ * 'result' zeroed) if memory ran out (ENOMEM) or if opts->black was started for another line
+ * length (EINVAL).
+ */
+REFLOW_API int reflow_buffer(const char *in, size_t len, const struct reflow_opts *opts,
+                             struct reflow_result *result);
+
+/* reflow_result_free()
+ * Releases result->text through the allocator of 'opts' (which may be NULL) and zeroes 'result'.
+ */
+REFLOW_API void reflow_result_free(struct reflow_result *result, const struct reflow_opts *opts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REFLOW_H */
@@ -24,46 +24,260 @@
  * 4. **Rule D: Reflow Existing Triple-Quoted Comment Blocks**
  *    If an existing triple-quoted block is found, its inner content is merged and rewrapped
  *    so that no resulting line (taking common indentation into account) exceeds 79 characters.
+ *    Only blocks that open at the indentation and close alone on a later line are reflowed,
+ *    and a block that is already exactly what it would be rewritten to is left alone.
+ *
+ * Every file is tokenized once: string literals are followed across lines, so that the rules
+ * see where real comments start and never treat a '#' inside a string as one.
  *
  * The program also removes trailing whitespace from comment blocks.
  *
+ * --line-length N replaces the 79-character limit everywhere, Black included, and --rules SET
+ * (e.g. --rules=BD) applies only the named rules. Every rule set has its own copy of the rule
+ * chain, compiled with the other rules left out, and the right one is picked at startup.
+ * --wrap=optimal makes Rules C and D choose their line breaks for the least ragged right edge
+ * instead of greedily; its output wraps to itself, so a second run finds nothing to change.
+ * --verify-idempotent checks that for a whole tree: every result is run through the rules again
+ * in memory, and files that would still change are reported.
+ *
  * Usage:
- *   reformat_print <path>
+ *   reformat_print [-j N] [--file-jobs N] [--black-workers N]
+ *                  [--check | --diff | --verify-idempotent] [--since REV] [--cache[=FILE]] [--snippet-cache=FILE] [--exclude GLOB]...
+ *                  [--no-ignore] [--stats[=json]] [--line-length N] [--rules SET]
+ *                  [--wrap=greedy|optimal] [--shard I/N [--shard-by hash|size]]
+ *                  [--emit-manifest FILE] [--daemon[=SOCKET]] <path>
+ *   reformat_print [--stats[=json]] --merge-results MANIFEST...
  *
+ * If <path> is "-", Python source is read from stdin and the result is written to stdout,
+ * holding only the comment block being processed in memory (messages go to stderr).
  * If <path> is a file, that single file is processed.
  * If <path> is a directory, the tool recursively finds all files with a ".py" extension
- * and processes each file.
+ * and processes each file. With -j N, N worker threads walk the tree and process the files
+ * in parallel (-j 0 starts one worker per online CPU); files of 256 KB or more are taken
+ * largest first, small ones in batches, and on NUMA machines each worker stays on one node.
+ * With --file-jobs N, the rules of a file of several megabytes are split over N threads too,
+ * at lines no rule reaches across. Version-control and node_modules directories and whatever
+ * .gitignore files in the tree exclude are skipped (--no-ignore walks everything), as is every
+ * entry matching an --exclude glob. Symlinks to directories are not followed.
+ *
+ * With --daemon, a directory is processed and then watched with inotify: files written or
+ * moved into the tree are processed again once things have been quiet for a moment, with
+ * Black and the cache kept warm in between. Editors can ask for a file to be processed at
+ * once through a Unix socket (SOCKET, by default .reflow.sock in the directory, open to its
+ * owner only); only files the walk of the tree would process are accepted.
+ *
+ * A run over a large tree can be spread over several machines: --shard I/N processes only the
+ * I-th of N parts of the files (split by path hash, or with --shard-by=size into parts of
+ * about the same number of bytes), and --emit-manifest FILE records what the node did, as JSON
+ * Lines. --merge-results reads the manifests of all N shards and reports them as one run.
+ *
+ * To measure throughput without touching any files, process a generated corpus in memory:
+ *   reformat_print --bench[=files=N,size=BYTES,inline=%,runs=%,docstrings=%,prints=%,seed=S,black=0|1]
  *
  * Dependencies:
  *   - Requires the Python code formatter "black" to be available in the system PATH.
+ *     Rule A snippets are queued to persistent Python helpers that import Black once per
+ *     run (the interpreter is taken from the "black" script's shebang, or from
+ *     $REFLOW_PYTHON); --black-workers N starts N of them. If that fails, the tool falls
+ *     back to one "black" run per snippet. Every result is remembered by snippet text, so
+ *     a print that recurs is formatted only once; --snippet-cache=FILE keeps them across runs.
  *
  * Compile with:
- *   gcc -O2 -g -o reformat_print reflow_comments.c
+ *   gcc -O2 -g -pthread -o reformat_print reflow_comments.c
+ *
+ * Or, to call black.format_str() in-process through an embedded CPython interpreter
+ * (no helper process at all; PYTHONPATH/PYTHONHOME select where Black is imported from):
+ *   gcc -O2 -g -pthread -DREFLOW_EMBED_PYTHON $(python3-config --includes) \
+ *       -o reformat_print reflow_comments.c $(python3-config --ldflags --embed)
+ *
+ * On Linux, -DREFLOW_IO_URING lets the -j workers open, stat and read batches of small files
+ * through an io_uring (set up with the raw system calls; no liburing), running the rules on
+ * each file as its read completes. Without a working ring they load files as usual:
+ *   gcc -O2 -g -pthread -DREFLOW_IO_URING -o reformat_print reflow_comments.c
  *
  * Then, for example, install:
  *   sudo mv reformat_print /usr/local/bin/
  *
+ * With -DREFLOW_NO_MAIN, the same file builds libreflow instead: reflow_buffer() and the other
+ * functions declared in reflow.h, which reflow a buffer in memory (see reflow.h for the commands).
+ *
  * Always back up your files or use version control before running this tool.
  */
 
+#define _GNU_SOURCE 1  // copy_file_range()
+#ifdef REFLOW_EMBED_PYTHON
+// Python.h must come before the system headers.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
 #include <string.h>
 #include <ctype.h>
 #include <unistd.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <getopt.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/uio.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <fnmatch.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <sys/inotify.h>
+#ifdef REFLOW_IO_URING
+#include <linux/io_uring.h>
+#endif
+#else
+#undef REFLOW_IO_URING // io_uring is Linux only; elsewhere the workers load files as usual
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "reflow.h"
 
 #define BUFFER_SIZE 8192
-#define MAX_LEN 79
+#define MAX_LEN 79 // default --line-length
+
+#ifdef __APPLE__
+#define st_mtim st_mtimespec
+#endif
+
+struct black_backend;
+struct file_cache;
+struct run_stats;
+struct rule_stats;
+struct source;
+struct edit;
+struct arena;
+struct change_set;
+struct walk_options;
+struct shard;
+struct manifest;
+
+/* enum output_mode
+ * What happens to a file's result: written back in place, only counted (--check), printed
+ * as a unified diff (--diff), or run through the rules once more to see that it stays as it
+ * is (--verify-idempotent). The last three never write anything.
+ */
+enum output_mode { OUTPUT_WRITE, OUTPUT_CHECK, OUTPUT_DIFF, OUTPUT_VERIFY };
+
+#define RULE_BIT(rule) (1u << (rule)) /* of an enum rule_id */
+#define RULES_ALL 0xfu
+
+/* enum wrap_mode
+ * How Rules C and D break text into lines: greedily (wrap_text_into()) or with the fewest
+ * ragged lines (wrap_text_optimal_into()).
+ */
+enum wrap_mode { WRAP_GREEDY, WRAP_OPTIMAL };
+
+/* struct rule_set
+ * The rules to apply (a mask of RULE_BIT()s), the line length they enforce, how they wrap,
+ * and the copy of the rule chain compiled for exactly that mask, which rule_set_init() picks
+ * once per run.
+ */
+struct rule_set {
+    unsigned mask;
+    int width;
+    enum wrap_mode wrap;
+    bool (*apply)(const struct source *src, size_t i, struct edit *e, struct arena *arena,
+                  struct rule_stats *stats);
+};
+
+/* struct run_context
+ * Run-wide state shared by every file processed in one invocation.
+ */
+struct run_context {
+    struct rule_set rules;
+    struct black_backend *bb;
+    struct file_cache *cache; /* NULL unless --cache was given */
+    struct run_stats *stats;  /* run totals; NULL unless --stats was given */
+    const struct change_set *changes; /* NULL unless --since was given */
+    const struct walk_options *walk;
+    const struct shard *shard;  /* NULL unless --shard was given */
+    struct manifest *manifest;  /* NULL unless --emit-manifest was given */
+    enum output_mode mode;
+    int file_jobs;              /* threads the rules of one large file are split over */
+    atomic_size_t would_change; /* files --check/--diff found needing changes, or that
+                                   --verify-idempotent found changing again */
+    atomic_size_t verified;     /* --verify-idempotent: files its first pass changed */
+    atomic_uint_fast64_t pass_ns[2]; /* --verify-idempotent: time in the rules of each pass */
+};
+
+/* struct line_span
+ * One line of a source buffer: 'len' bytes starting at 'off', including the line terminator
+ * (the last line of a file may have none), with what the tokenizer found in it. Offsets are
+ * relative to the start of the line; NO_OFFSET means there is none.
+ */
+struct line_span {
+    size_t off, len;
+    unsigned flags;    /* LINE_* */
+    uint32_t indent;   /* first non-space byte */
+    uint32_t comment;  /* the '#' that starts the comment (LINE_HASH) */
+    uint32_t tq_close; /* the """ that closes the string (LINE_TQ) */
+};
+
+#define NO_OFFSET UINT32_MAX
+
+/* Per-line facts from the tokenizer, so the rules only look at lines they can apply to. */
+#define LINE_HASH      0x01u /* has a comment: a '#' outside any string literal */
+#define LINE_QUOTE     0x02u /* contains a quote character (' or ") */
+#define LINE_TQ        0x04u /* closes a """ string opened on an earlier line */
+#define LINE_TQ_OPEN   0x08u /* opens a standalone """ block at its indentation (Rule D) */
+#define LINE_LONG      0x10u /* longer than the source's width, terminator included */
+#define LINE_COMMENT   0x20u /* full-line comment: the '#' is the first non-space byte */
+#define LINE_IN_STRING 0x40u /* starts inside a string literal opened on an earlier line */
+#define LINE_TQ_START  0x80u /* a """ string starts at the indentation and continues past the line */
+/* Rules A-C need a long line with a comment; Rule D the first line of a standalone """ block. */
+#define LINE_IS_CANDIDATE(flags) \
+    ((((flags) & (LINE_HASH | LINE_LONG)) == (LINE_HASH | LINE_LONG)) || ((flags) & LINE_TQ_OPEN))
+
+/* struct source
+ * A file's contents, mapped (or read) once, plus the index of its lines. The rules read the
+ * lines in place through the spans instead of working on per-line copies.
+ */
+struct source {
+    const char *data;
+    size_t size;
+    int width;         /* line length the rules enforce; set before scan_source() */
+    enum wrap_mode wrap; /* how Rules C and D wrap */
+    bool mapped;
+    int fd;            /* kept open for copy_source_range(); -1 if there is none */
+    struct line_span *lines;
+    size_t count;
+    size_t candidates; /* lines with LINE_IS_CANDIDATE() */
+};
 
 // Forward declarations of processing functions.
-char *process_commented_print_line(const char *original_line);
-char *split_inline_comment(const char *original_line);
-char *merge_comment_block(char **lines, size_t start, size_t count, size_t *end_index);
+char *process_commented_print_line(const char *line, size_t len, struct black_backend *bb,
+                                   struct arena *arena);
+char *split_inline_comment(const struct source *src, size_t i, struct arena *arena);
+char *merge_comment_block(const struct source *src, size_t start, size_t *end_index,
+                          struct arena *arena);
+struct strbuf;
+bool wrap_text_into(struct strbuf *out, const char *text, size_t len, int max_width);
+bool wrap_text_optimal_into(struct strbuf *out, const char *text, size_t len, int max_width);
 char *wrap_text(const char *text, int max_width);
-char *process_triple_quote_block(char **lines, size_t start, size_t count, size_t *end_index);
+char *process_triple_quote_block(const struct source *src, size_t start, size_t *end_index,
+                                 struct arena *arena);
+int load_source(const char *filename, int width, struct source *src);
+void free_source(struct source *src);
+uint64_t xxh64(const void *data, size_t len, uint64_t seed);
 
 // ----------------- Helper Functions -----------------
 
@@ -96,29 +310,43 @@ void ltrim(char *s) {
         memmove(s, s+index, strlen(s+index) + 1);
 }
 
-/* is_full_line_comment()
- * Returns true if, after optional indentation, the line begins with '#'.
+/* line_content_length()
+ * Returns the length of a line span without its trailing newline and carriage return characters.
+ */
+size_t line_content_length(const char *line, size_t len) {
+    while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r'))
+        len--;
+    return len;
+}
+
+/* skip_space()
+ * Returns the index of the first non-whitespace byte of line[pos, len), or len if there is none.
  */
-bool is_full_line_comment(const char *line) {
-    const char *p = line;
-    while (*p && isspace((unsigned char)*p))
-        p++;
-    return (*p == '#');
+size_t skip_space(const char *line, size_t pos, size_t len) {
+    while (pos < len && isspace((unsigned char)line[pos]))
+        pos++;
+    return pos;
+}
+
+/* now_ns()
+ * Returns a monotonic timestamp in nanoseconds.
+ */
+uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
 }
 
 /* is_commented_print()
  * Heuristically checks if a full-line comment (after indentation) is a commented-out print statement.
  */
-bool is_commented_print(const char *line) {
-    const char *p = line;
-    while (*p && isspace((unsigned char)*p))
-        p++;
-    if (*p != '#')
+bool is_commented_print(const char *line, size_t len) {
+    size_t p = skip_space(line, 0, len);
+    if (p >= len || line[p] != '#')
         return false;
     p++; // skip '#'
-    while (*p && isspace((unsigned char)*p))
-        p++;
-    return (strncmp(p, "print(", 6) == 0);
+    p = skip_space(line, p, len);
+    return (len - p >= 6 && strncmp(line + p, "print(", 6) == 0);
 }
 
 /* check_black_available()
@@ -130,11 +358,11 @@ bool check_black_available() {
 }
 
 /* run_black()
- * Runs the "black" formatter on a temporary file with a maximum line length of MAX_LEN.
+ * Runs the "black" formatter on a temporary file with a maximum line length of 'width'.
  */
-bool run_black(const char *tmp_filename) {
+bool run_black(const char *tmp_filename, int width) {
     char cmd[BUFFER_SIZE];
-    snprintf(cmd, BUFFER_SIZE, "black --line-length %d %s > /dev/null 2>&1", MAX_LEN, tmp_filename);
+    snprintf(cmd, BUFFER_SIZE, "black --line-length %d %s > /dev/null 2>&1", width, tmp_filename);
     int ret = system(cmd);
     return (ret == 0);
 }
@@ -166,89 +394,748 @@ char *read_file_contents(FILE *fp) {
     return result;
 }
 
-/* wrap_text()
- * Wraps a single long string (with no newlines) into multiple lines,
- * ensuring that each line is at most max_width characters.
- * It uses a heuristic: it searches backward and forward for a break character.
+// ----------------- Arena -----------------
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+struct arena_block {
+    struct arena_block *next;
+    size_t size, used;
+    _Alignas(ARENA_ALIGN) char data[];
+};
+
+/* struct arena
+ * Bump allocator for everything the rules produce while one file is processed. Allocations
+ * are never freed one by one; arena_reset() releases all of them at once after each file.
+ * 'last' is the most recent allocation, which can still be grown in place. Blocks come from
+ * 'allocator', or from malloc() if it is NULL.
  */
-char *wrap_text(const char *text, int max_width) {
-    size_t len = strlen(text);
-    if (len <= (size_t)max_width)
-        return strdup(text);
-    int found = -1;
-    const char *break_chars = " ,.:;";
-    for (int i = max_width; i >= 0; i--) {
-        if (strchr(break_chars, text[i])) {
-            found = i;
-            break;
+struct arena {
+    struct arena_block *blocks;
+    char *last;
+    struct arena_block *last_block;
+    const struct reflow_allocator *allocator;
+};
+
+static size_t arena_round(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+static void *arena_block_alloc(struct arena *a, size_t size) {
+    return a->allocator ? a->allocator->alloc(size, a->allocator->ctx) : malloc(size);
+}
+
+static void arena_block_release(struct arena *a, struct arena_block *blk) {
+    if (a->allocator)
+        a->allocator->release(blk, a->allocator->ctx);
+    else
+        free(blk);
+}
+
+/* arena_alloc()
+ * Returns n bytes from the arena, or NULL on allocation failure. Requests larger than a
+ * quarter block get a block of their own, so they do not waste the rest of the current one.
+ */
+void *arena_alloc(struct arena *a, size_t n) {
+    n = arena_round(n ? n : 1);
+    struct arena_block *blk = a->blocks;
+    if (!blk || blk->size - blk->used < n) {
+        size_t size = (n > ARENA_BLOCK_SIZE / 4) ? n : ARENA_BLOCK_SIZE;
+        struct arena_block *fresh = arena_block_alloc(a, sizeof(*fresh) + size);
+        if (!fresh)
+            return NULL;
+        fresh->size = size;
+        fresh->used = 0;
+        if (blk && size != ARENA_BLOCK_SIZE) {
+            // Keep bumping from the current block.
+            fresh->next = blk->next;
+            blk->next = fresh;
+        } else {
+            fresh->next = blk;
+            a->blocks = fresh;
+        }
+        blk = fresh;
+    }
+    char *p = blk->data + blk->used;
+    blk->used += n;
+    a->last = p;
+    a->last_block = blk;
+    return p;
+}
+
+/* arena_grow()
+ * Resizes an allocation of old_size bytes to new_size bytes. The most recent allocation is
+ * extended in place when its block has room; otherwise the data is copied to a new one.
+ */
+void *arena_grow(struct arena *a, void *ptr, size_t old_size, size_t new_size) {
+    struct arena_block *blk = a->last_block;
+    if (ptr && ptr == a->last) {
+        size_t start = (size_t)((char *)ptr - blk->data);
+        if (start + arena_round(new_size) <= blk->size) {
+            blk->used = start + arena_round(new_size);
+            return ptr;
+        }
+    }
+    void *p = arena_alloc(a, new_size);
+    if (p && ptr)
+        memcpy(p, ptr, old_size);
+    return p;
+}
+
+/* arena_reset()
+ * Releases every allocation. One standard block is kept for the next file.
+ */
+void arena_reset(struct arena *a) {
+    struct arena_block *keep = NULL;
+    struct arena_block *blk = a->blocks;
+    while (blk) {
+        struct arena_block *next = blk->next;
+        if (!keep && blk->size == ARENA_BLOCK_SIZE) {
+            keep = blk;
+            keep->used = 0;
+            keep->next = NULL;
+        } else {
+            arena_block_release(a, blk);
         }
+        blk = next;
     }
-    if (found == -1) {
-        for (int i = max_width + 1; i < (int)len && i < max_width + 10; i++) {
-            if (strchr(break_chars, text[i])) {
+    a->blocks = keep;
+    a->last = NULL;
+    a->last_block = NULL;
+}
+
+void arena_free(struct arena *a) {
+    arena_reset(a);
+    if (a->blocks)
+        arena_block_release(a, a->blocks);
+    a->blocks = NULL;
+}
+
+/* struct strbuf
+ * Growable byte buffer. Its data is kept NUL-terminated so it can be used as a string.
+ * With an arena set, the buffer lives in the arena and strbuf_free() does not release it.
+ */
+struct strbuf {
+    char *data;
+    size_t len, capacity;
+    struct arena *arena;
+};
+
+/* strbuf_reserve()
+ * Makes room for 'extra' more bytes (plus the terminator). Returns false on allocation failure,
+ * leaving the buffer as it was.
+ */
+bool strbuf_reserve(struct strbuf *sb, size_t extra) {
+    if (sb->len + extra + 1 <= sb->capacity)
+        return true;
+    size_t capacity = sb->capacity;
+    if (capacity == 0)
+        capacity = sb->arena ? 64 : BUFFER_SIZE;
+    while (capacity < sb->len + extra + 1)
+        capacity *= 2;
+    char *tmp = sb->arena ? arena_grow(sb->arena, sb->data, sb->len + 1, capacity)
+                          : realloc(sb->data, capacity);
+    if (!tmp)
+        return false;
+    sb->data = tmp;
+    sb->capacity = capacity;
+    return true;
+}
+
+/* strbuf_append()
+ * Appends n bytes of s. Returns false on allocation failure.
+ */
+bool strbuf_append(struct strbuf *sb, const char *s, size_t n) {
+    if (!strbuf_reserve(sb, n))
+        return false;
+    memcpy(sb->data + sb->len, s, n);
+    sb->len += n;
+    sb->data[sb->len] = '\0';
+    return true;
+}
+
+/* strbuf_pad()
+ * Appends n copies of c. Returns false on allocation failure.
+ */
+bool strbuf_pad(struct strbuf *sb, char c, size_t n) {
+    if (!strbuf_reserve(sb, n))
+        return false;
+    memset(sb->data + sb->len, c, n);
+    sb->len += n;
+    sb->data[sb->len] = '\0';
+    return true;
+}
+
+/* strbuf_append_piece()
+ * Appends n bytes of s plus a separating space, for gathering lines into one paragraph.
+ */
+bool strbuf_append_piece(struct strbuf *sb, const char *s, size_t n) {
+    return strbuf_append(sb, s, n) && strbuf_append(sb, " ", 1);
+}
+
+void strbuf_free(struct strbuf *sb) {
+    struct arena *arena = sb->arena;
+    if (!arena)
+        free(sb->data);
+    memset(sb, 0, sizeof(*sb));
+    sb->arena = arena;
+}
+
+/* Characters wrap_text_into() may break a line at. */
+static const unsigned char wrap_break_chars[256] = {
+    [' '] = 1, [','] = 1, ['.'] = 1, [':'] = 1, [';'] = 1,
+};
+
+/* wrap_text_into()
+ * Wraps a single long string of len bytes into lines of at most max_width characters and
+ * appends them, separated by newlines, to 'out'. It uses a heuristic: for each line it searches
+ * backward from max_width, then up to 10 characters forward, for a break character. The break
+ * characters (and any whitespace) after a break are dropped. Runs in a single pass over the
+ * text. Returns false on allocation failure.
+ */
+bool wrap_text_into(struct strbuf *out, const char *text, size_t len, int max_width) {
+    if (max_width < 1)
+        max_width = 1;
+    size_t width = (size_t)max_width;
+    if (!strbuf_reserve(out, len + len / width + 1))
+        return false;
+    size_t pos = 0;
+    while (len - pos > width) {
+        const unsigned char *t = (const unsigned char *)text + pos;
+        size_t remaining = len - pos;
+        size_t found = width;
+        bool have_break = false;
+        for (size_t i = width + 1; i-- > 0; ) {
+            if (wrap_break_chars[t[i]]) {
                 found = i;
+                have_break = true;
                 break;
             }
         }
+        for (size_t i = width + 1; !have_break && i < remaining && i < width + 10; i++) {
+            if (wrap_break_chars[t[i]]) {
+                found = i;
+                have_break = true;
+            }
+        }
+        size_t skip = found;
+        while (skip < remaining && wrap_break_chars[t[skip]])
+            skip++;
+        while (skip < remaining && isspace(t[skip]))
+            skip++;
+        if (!strbuf_append(out, text + pos, found) || !strbuf_append(out, "\n", 1))
+            return false;
+        pos += skip;
+    }
+    return strbuf_append(out, text + pos, len - pos);
+}
+
+/* struct wrap_word
+ * A word of the text wrap_text_optimal_into() lays out, and the best layout of the words from
+ * it to the end: its cost and the word that starts the next line.
+ */
+struct wrap_word {
+    size_t off, len;
+    uint64_t cost;
+    size_t next;
+};
+
+/* wrap_text_optimal_into()
+ * Wraps text like wrap_text_into(), but breaks only at whitespace and picks the breaks that
+ * minimize the sum of the squared space left at the end of every line but the last (minimum
+ * raggedness, as in Knuth and Plass). Words are joined by single spaces and never split; a word
+ * longer than max_width gets a line of its own. Since a line holds at most max_width / 2 + 1
+ * words, the dynamic program only looks one line ahead of every word and takes O(len * max_width)
+ * time at worst. The result depends only on the sequence of words, so wrapping its own output
+ * again gives the same lines. Returns false on allocation failure.
+ */
+bool wrap_text_optimal_into(struct strbuf *out, const char *text, size_t len, int max_width) {
+    if (max_width < 1)
+        max_width = 1;
+    size_t width = (size_t)max_width;
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++)
+        if (!isspace((unsigned char)text[i]) && (i == 0 || isspace((unsigned char)text[i-1])))
+            n++;
+    if (n == 0)
+        return strbuf_reserve(out, 0);
+    struct wrap_word *words = out->arena ? arena_alloc(out->arena, n * sizeof(*words))
+                                         : malloc(n * sizeof(*words));
+    if (!words)
+        return false;
+    size_t k = 0;
+    for (size_t i = 0; i < len; ) {
+        while (i < len && isspace((unsigned char)text[i]))
+            i++;
+        if (i == len)
+            break;
+        words[k].off = i;
+        while (i < len && !isspace((unsigned char)text[i]))
+            i++;
+        words[k].len = i - words[k].off;
+        k++;
+    }
+    // Best layouts from the last word back: a line runs from word i up to word j.
+    for (size_t i = n; i-- > 0; ) {
+        size_t line = words[i].len;
+        words[i].cost = UINT64_MAX;
+        for (size_t j = i; j < n; j++) {
+            if (j > i) {
+                line += 1 + words[j].len;
+                if (line > width)
+                    break;
+            }
+            uint64_t slack = line < width ? width - line : 0;
+            uint64_t cost = (j + 1 == n) ? 0 : slack * slack + words[j + 1].cost;
+            if (cost <= words[i].cost) {
+                words[i].cost = cost;
+                words[i].next = j + 1;
+            }
+        }
     }
-    if (found == -1)
-        found = max_width;
-    char *first_part = strndup(text, found);
-    int skip = 0;
-    while (found + skip < (int)len && strchr(break_chars, text[found + skip]))
-        skip++;
-    while (found + skip < (int)len && isspace((unsigned char)text[found + skip]))
-        skip++;
-    char *remaining = strdup(text + found + skip);
-    char *wrapped_remaining = wrap_text(remaining, max_width);
-    free(remaining);
-    size_t total_size = strlen(first_part) + 2 + strlen(wrapped_remaining) + 1;
-    char *result = malloc(total_size);
-    if (!result) {
-        free(first_part);
-        free(wrapped_remaining);
+    bool ok = strbuf_reserve(out, len + n);
+    for (size_t i = 0; ok && i < n; ) {
+        size_t next = words[i].next;
+        for (size_t j = i; ok && j < next; j++)
+            ok = strbuf_append(out, text + words[j].off, words[j].len) &&
+                 (j + 1 == next || strbuf_append(out, " ", 1));
+        if (ok && next < n)
+            ok = strbuf_append(out, "\n", 1);
+        i = next;
+    }
+    if (!out->arena)
+        free(words);
+    return ok;
+}
+
+/* wrap_text()
+ * Returns a newly allocated copy of text wrapped by wrap_text_into(), or NULL on failure.
+ */
+char *wrap_text(const char *text, int max_width) {
+    struct strbuf out = {0};
+    if (!wrap_text_into(&out, text, strlen(text), max_width)) {
+        strbuf_free(&out);
         return NULL;
     }
-    snprintf(result, total_size, "%s\n%s", first_part, wrapped_remaining);
-    free(first_part);
-    free(wrapped_remaining);
-    return result;
+    return out.data;
 }
 
-// ----------------- Processing Rules -----------------
+// ----------------- Black Backend -----------------
 
-/* Rule A: Process a commented-out print statement.
- * If a full-line comment starts with "print(" (after '#' and whitespace) and the line exceeds MAX_LEN,
- * this function extracts the code (removing the '#' and spaces), writes it to a temporary file,
- * runs Black on it, reads back the formatted output, and then wraps the result in a triple-quoted block.
- * Returns a newly allocated string (with trailing newline) if modified, or NULL otherwise.
- */
-char *process_commented_print_line(const char *original_line) {
-    char buffer[BUFFER_SIZE];
-    strncpy(buffer, original_line, BUFFER_SIZE-1);
-    buffer[BUFFER_SIZE-1] = '\0';
-    strip_crlf(buffer);
-    if (strlen(buffer) <= MAX_LEN)
-        return NULL;
-    if (!is_commented_print(buffer))
-        return NULL;
-    char *hash_ptr = strchr(buffer, '#');
-    if (!hash_ptr)
-        return NULL;
-    int code_len = hash_ptr - buffer;
-    if (code_len >= MAX_LEN)
-        return NULL;
-    char *comment_content = hash_ptr + 1;
-    while (*comment_content && isspace((unsigned char)*comment_content))
-        comment_content++;
-    if (strncmp(comment_content, "def ", 4) == 0)
-        return NULL;
-    int indent = 0;
-    while (buffer[indent] && isspace((unsigned char)buffer[indent]))
-        indent++;
-    char *code = hash_ptr + 1;
-    while (*code && isspace((unsigned char)*code))
-        code++;
+/* Python helper run by the persistent Black backend.
+ * Protocol (all lengths in bytes):
+ *   helper -> tool: "READY <black version>\n" once, after Black has been imported.
+ *   tool -> helper: "BATCH <n> <line length>\n" followed by n frames "<len>\n<source>".
+ *   helper -> tool: n frames "OK <len>\n<formatted>" or "ERR <len>\n<message>".
+ * The helper reads a whole batch before answering, so the tool can write every frame
+ * before it starts reading without the two sides blocking on full pipes.
+ */
+static const char *black_helper_script =
+    "import sys\n"
+    "try:\n"
+    "    import black\n"
+    "except Exception:\n"
+    "    sys.exit(3)\n"
+    "inp, out = sys.stdin.buffer, sys.stdout.buffer\n"
+    "out.write(('READY %s\\n' % black.__version__).encode())\n"
+    "out.flush()\n"
+    "while True:\n"
+    "    hdr = inp.readline().split()\n"
+    "    if len(hdr) != 3 or hdr[0] != b'BATCH':\n"
+    "        break\n"
+    "    mode = black.Mode(line_length=int(hdr[2]))\n"
+    "    srcs = [inp.read(int(inp.readline())) for _ in range(int(hdr[1]))]\n"
+    "    for src in srcs:\n"
+    "        try:\n"
+    "            res, tag = black.format_str(src.decode(), mode=mode).encode(), b'OK'\n"
+    "        except Exception as e:\n"
+    "            res, tag = str(e).encode(), b'ERR'\n"
+    "        out.write(b'%s %d\\n' % (tag, len(res)))\n"
+    "        out.write(res)\n"
+    "    out.flush()\n";
+
+/* struct black_helper
+ * One persistent helper process; pid is -1 when there is none.
+ */
+struct black_helper {
+    pid_t pid;
+    FILE *to_helper;
+    FILE *from_helper;
+};
+
+/* struct memo_entry
+ * A snippet and what Black made of it.
+ */
+struct memo_entry {
+    uint64_t hash;
+    char *snippet; /* NULL for an empty slot */
+    char *result;
+};
+
+/* struct snippet_memo
+ * Black results by snippet text, so that a commented-out print seen before is not formatted
+ * again. All entries were formatted with the same line length and Black version, which the
+ * fingerprint covers when the memo is stored in 'filename'. Open addressing; the capacity is
+ * a power of two.
+ */
+struct snippet_memo {
+    pthread_mutex_t lock;
+    struct memo_entry *slots;
+    size_t capacity, used;
+    char filename[BUFFER_SIZE]; /* "" if it is not stored */
+    uint64_t fingerprint;
+    bool dirty;
+};
+
+/* struct black_job
+ * n snippets formatted together. Once 'done' is set (under the backend's lock), results[i]
+ * holds a newly allocated result for snippets[i], or NULL on failure.
+ */
+struct black_job {
+    char **snippets;
+    char **results;
+    size_t n;
+    uint64_t ns;            /* time spent formatting */
+    size_t hits;            /* snippets answered from the memo */
+    bool done;
+    struct black_job *next; /* in the backend's queue */
+};
+
+/* struct black_worker
+ * A thread that takes jobs off the backend's queue, and the helper it sends them to.
+ */
+struct black_worker {
+    struct black_backend *bb;
+    struct black_helper helper;
+    pthread_t thread;
+};
+
+/* struct black_backend
+ * Formats Rule A snippets. Jobs are queued and picked up by a pool of worker threads, so
+ * callers can go on with other work while Black runs. In builds with REFLOW_EMBED_PYTHON,
+ * 'embedded' means Black runs in this process. Otherwise every worker owns a helper process
+ * that it sends its jobs to; a worker without one formats every snippet by a separate
+ * "black" run.
+ */
+struct black_backend {
+    pthread_mutex_t lock;    /* guards the queue and the jobs' 'done' flags */
+    pthread_cond_t queued;   /* a job was queued, or the workers should stop */
+    pthread_cond_t finished; /* a job is done */
+    struct black_job *head, *tail;
+    bool stopping;
+    struct black_worker *workers;
+    size_t nworkers;         /* running worker threads; with none, jobs run in the caller */
+    struct snippet_memo memo;
+    int line_length;         /* what every snippet is formatted for */
+    char version[64];
+#ifdef REFLOW_EMBED_PYTHON
+    bool embedded;
+    PyObject *format_str; /* black.format_str */
+    PyObject *kwargs;     /* {"mode": black.Mode(line_length=line_length)} */
+    PyThreadState *main_thread;
+#endif
+};
+
+/* set_cloexec()
+ * Marks a descriptor close-on-exec so helper processes do not inherit each other's pipes.
+ */
+static void set_cloexec(int fd) {
+    int flags = fcntl(fd, F_GETFD);
+    if (flags != -1)
+        fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+}
+
+/* find_black_python()
+ * Picks the interpreter for the helper: $REFLOW_PYTHON if set, otherwise the interpreter
+ * named in the shebang of the "black" script found in PATH, otherwise "python3".
+ */
+static void find_black_python(char *python, size_t size) {
+    const char *env = getenv("REFLOW_PYTHON");
+    if (env && *env) {
+        snprintf(python, size, "%s", env);
+        return;
+    }
+    snprintf(python, size, "python3");
+    char script[BUFFER_SIZE] = "";
+    FILE *p = popen("command -v black 2>/dev/null", "r");
+    if (!p)
+        return;
+    if (!fgets(script, sizeof(script), p))
+        script[0] = '\0';
+    pclose(p);
+    strip_crlf(script);
+    if (!script[0])
+        return;
+    FILE *fp = fopen(script, "r");
+    if (!fp)
+        return;
+    char shebang[BUFFER_SIZE];
+    if (!fgets(shebang, sizeof(shebang), fp) || strncmp(shebang, "#!", 2) != 0 ||
+        !strstr(shebang, "python")) {
+        fclose(fp);
+        return;
+    }
+    fclose(fp);
+    strip_crlf(shebang);
+    char *saveptr;
+    char *interp = strtok_r(shebang + 2, " \t", &saveptr);
+    // "#!/usr/bin/env python3" names the interpreter in the second word.
+    if (interp && strlen(interp) >= 4 && strcmp(interp + strlen(interp) - 4, "/env") == 0)
+        interp = strtok_r(NULL, " \t", &saveptr);
+    if (interp && strstr(interp, "python"))
+        snprintf(python, size, "%s", interp);
+}
+
+#ifdef REFLOW_EMBED_PYTHON
+/* black_embed_start()
+ * Initializes the embedded interpreter, imports Black and prepares the call to format_str().
+ * On success the GIL is released so that any thread can format with black_embed_format().
+ * Returns false (with the interpreter shut down again) if Black cannot be imported.
+ */
+static bool black_embed_start(struct black_backend *bb) {
+    Py_InitializeEx(0); // Leave signal handling to this program.
+    PyObject *black = PyImport_ImportModule("black");
+    PyObject *mode_class = black ? PyObject_GetAttrString(black, "Mode") : NULL;
+    PyObject *version = black ? PyObject_GetAttrString(black, "__version__") : NULL;
+    PyObject *empty = PyTuple_New(0);
+    PyObject *mode_args = Py_BuildValue("{s:i}", "line_length", bb->line_length);
+    PyObject *mode = (mode_class && empty && mode_args) ? PyObject_Call(mode_class, empty, mode_args) : NULL;
+    bb->format_str = black ? PyObject_GetAttrString(black, "format_str") : NULL;
+    bb->kwargs = mode ? Py_BuildValue("{s:O}", "mode", mode) : NULL;
+    const char *v = version ? PyUnicode_AsUTF8(version) : NULL;
+    if (v)
+        snprintf(bb->version, sizeof(bb->version), "%.63s", v);
+    Py_XDECREF(mode);
+    Py_XDECREF(mode_args);
+    Py_XDECREF(empty);
+    Py_XDECREF(version);
+    Py_XDECREF(mode_class);
+    Py_XDECREF(black);
+    if (!bb->format_str || !bb->kwargs || !v) {
+        PyErr_Clear();
+        Py_XDECREF(bb->format_str);
+        Py_XDECREF(bb->kwargs);
+        bb->format_str = bb->kwargs = NULL;
+        bb->version[0] = '\0';
+        Py_FinalizeEx();
+        return false;
+    }
+    bb->embedded = true;
+    bb->main_thread = PyEval_SaveThread();
+    return true;
+}
+
+/* black_embed_format()
+ * Formats n snippets with black.format_str() under one acquisition of the GIL.
+ */
+static void black_embed_format(struct black_backend *bb, char **snippets, size_t n, char **results) {
+    PyGILState_STATE gil = PyGILState_Ensure();
+    for (size_t i = 0; i < n; i++) {
+        PyObject *args = Py_BuildValue("(s)", snippets[i]);
+        PyObject *out = args ? PyObject_Call(bb->format_str, args, bb->kwargs) : NULL;
+        const char *text = out ? PyUnicode_AsUTF8(out) : NULL;
+        results[i] = text ? strdup(text) : NULL;
+        if (!text)
+            PyErr_Clear();
+        Py_XDECREF(out);
+        Py_XDECREF(args);
+    }
+    PyGILState_Release(gil);
+}
+
+static void black_embed_stop(struct black_backend *bb) {
+    PyEval_RestoreThread(bb->main_thread);
+    Py_XDECREF(bb->format_str);
+    Py_XDECREF(bb->kwargs);
+    bb->format_str = bb->kwargs = NULL;
+    bb->embedded = false;
+    Py_FinalizeEx();
+}
+#endif
+
+/* helper_stop()
+ * Shuts a helper down (closing its stdin ends its loop) and reaps it.
+ */
+static void helper_stop(struct black_helper *h) {
+    if (h->to_helper)
+        fclose(h->to_helper);
+    if (h->from_helper)
+        fclose(h->from_helper);
+    if (h->pid > 0)
+        waitpid(h->pid, NULL, 0);
+    h->to_helper = h->from_helper = NULL;
+    h->pid = -1;
+}
+
+/* helper_spawn()
+ * Starts a helper process running 'python' without waiting for it to import Black.
+ * Returns false (leaving h->pid at -1) if it cannot be started.
+ */
+static bool helper_spawn(struct black_helper *h, const char *python) {
+    int to_child[2], from_child[2];
+    if (pipe(to_child) == -1)
+        return false;
+    if (pipe(from_child) == -1) {
+        close(to_child[0]);
+        close(to_child[1]);
+        return false;
+    }
+    set_cloexec(to_child[1]);
+    set_cloexec(from_child[0]);
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork");
+        close(to_child[0]);
+        close(to_child[1]);
+        close(from_child[0]);
+        close(from_child[1]);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull != -1)
+            dup2(devnull, STDERR_FILENO);
+        if (to_child[0] > STDERR_FILENO)
+            close(to_child[0]);
+        if (from_child[1] > STDERR_FILENO)
+            close(from_child[1]);
+        execlp(python, python, "-c", black_helper_script, (char *)NULL);
+        _exit(127);
+    }
+    close(to_child[0]);
+    close(from_child[1]);
+    h->pid = pid;
+    h->to_helper = fdopen(to_child[1], "w");
+    h->from_helper = fdopen(from_child[0], "r");
+    if (!h->to_helper || !h->from_helper) {
+        if (!h->to_helper)
+            close(to_child[1]);
+        if (!h->from_helper)
+            close(from_child[0]);
+        helper_stop(h);
+        return false;
+    }
+    return true;
+}
+
+/* helper_ready()
+ * Waits for a spawned helper to report that Black is imported and stores Black's version in
+ * 'version'. Returns false (with the helper stopped) if it fails to.
+ */
+static bool helper_ready(struct black_helper *h, char *version, size_t size) {
+    if (h->pid <= 0)
+        return false;
+    char line[BUFFER_SIZE];
+    if (!fgets(line, sizeof(line), h->from_helper) || strncmp(line, "READY ", 6) != 0) {
+        helper_stop(h);
+        return false;
+    }
+    strip_crlf(line);
+    snprintf(version, size, "%.63s", line + 6);
+    return true;
+}
+
+static void *black_worker_main(void *arg);
+static void memo_close(struct snippet_memo *m);
+
+/* black_stop()
+ * Shuts the backend down: lets the workers finish the queued jobs and joins them, stops their
+ * helpers, and finalizes the embedded interpreter.
+ */
+void black_stop(struct black_backend *bb) {
+    pthread_mutex_lock(&bb->lock);
+    bb->stopping = true;
+    pthread_cond_broadcast(&bb->queued);
+    pthread_mutex_unlock(&bb->lock);
+    for (size_t i = 0; i < bb->nworkers; i++) {
+        pthread_join(bb->workers[i].thread, NULL);
+        helper_stop(&bb->workers[i].helper);
+    }
+    free(bb->workers);
+    bb->workers = NULL;
+    bb->nworkers = 0;
+    memo_close(&bb->memo);
+#ifdef REFLOW_EMBED_PYTHON
+    if (bb->embedded)
+        black_embed_stop(bb);
+#endif
+}
+
+/* black_start()
+ * Starts the embedded interpreter (in REFLOW_EMBED_PYTHON builds) or else 'nworkers' helpers,
+ * and the worker threads that feed them, to format for a maximum line length of 'line_length'.
+ * All helpers are started before any is waited for, so they import Black concurrently. Black
+ * runs under the GIL, so the embedded interpreter only gets one worker. Returns false if
+ * neither the interpreter nor any helper can import Black; the workers then format with the
+ * "black" command.
+ */
+bool black_start(struct black_backend *bb, int nworkers, int line_length) {
+    memset(bb, 0, sizeof(*bb));
+    bb->line_length = line_length;
+    pthread_mutex_init(&bb->lock, NULL);
+    pthread_cond_init(&bb->queued, NULL);
+    pthread_cond_init(&bb->finished, NULL);
+    pthread_mutex_init(&bb->memo.lock, NULL);
+    bb->workers = calloc(nworkers, sizeof(struct black_worker));
+    if (!bb->workers) {
+        perror("calloc");
+        return false;
+    }
+    for (int i = 0; i < nworkers; i++) {
+        bb->workers[i].bb = bb;
+        bb->workers[i].helper.pid = -1;
+    }
+    bool ready = false;
+#ifdef REFLOW_EMBED_PYTHON
+    if (black_embed_start(bb)) {
+        ready = true;
+        nworkers = 1;
+    }
+#endif
+    if (!ready) {
+        char python[BUFFER_SIZE];
+        find_black_python(python, sizeof(python));
+        for (int i = 0; i < nworkers; i++)
+            helper_spawn(&bb->workers[i].helper, python);
+        for (int i = 0; i < nworkers; i++)
+            if (helper_ready(&bb->workers[i].helper, bb->version, sizeof(bb->version)))
+                ready = true;
+    }
+    for (int i = 0; i < nworkers; i++) {
+        if (pthread_create(&bb->workers[i].thread, NULL, black_worker_main, &bb->workers[i]) != 0) {
+            for (int k = i; k < nworkers; k++)
+                helper_stop(&bb->workers[k].helper);
+            break;
+        }
+        bb->nworkers++;
+    }
+    return ready;
+}
+
+/* black_cli_version()
+ * Records the version reported by the "black" command, for backends without a helper.
+ */
+void black_cli_version(struct black_backend *bb) {
+    snprintf(bb->version, sizeof(bb->version), "unknown");
+    FILE *p = popen("black --version 2>/dev/null", "r");
+    if (!p)
+        return;
+    char line[BUFFER_SIZE];
+    if (fgets(line, sizeof(line), p)) {
+        strip_crlf(line);
+        snprintf(bb->version, sizeof(bb->version), "%.63s", line);
+    }
+    pclose(p);
+}
+
+/* format_with_black_cli()
+ * Formats one snippet by writing it to a temporary file and running the "black" command.
+ * Returns the newly allocated formatted code, or NULL on failure.
+ */
+static char *format_with_black_cli(const char *code, int width) {
     char tmp_filename[] = "/tmp/blacktmpXXXXXX";
     int fd = mkstemp(tmp_filename);
     if (fd == -1) {
@@ -261,10 +1148,9 @@ char *process_commented_print_line(const char *original_line) {
         close(fd);
         return NULL;
     }
-    fprintf(tmp_file, "%s\n", code);
+    fputs(code, tmp_file);
     fclose(tmp_file);
-    if (!run_black(tmp_filename)) {
-        fprintf(stderr, "Error: Failed to run black. Ensure it is in your PATH.\n");
+    if (!run_black(tmp_filename, width)) {
         remove(tmp_filename);
         return NULL;
     }
@@ -277,484 +1163,6081 @@ char *process_commented_print_line(const char *original_line) {
     char *formatted = read_file_contents(fp);
     fclose(fp);
     remove(tmp_filename);
-    if (!formatted)
-        return NULL;
-    strip_crlf(formatted);
-    if (formatted[0] == '#') {
-        memmove(formatted, formatted+1, strlen(formatted));
-        while (*formatted && isspace((unsigned char)*formatted))
-            memmove(formatted, formatted+1, strlen(formatted));
-    }
-    // Build the triple-quoted block.
-    size_t new_capacity = BUFFER_SIZE;
-    char *new_content = malloc(new_capacity);
-    if (!new_content) {
-        free(formatted);
-        return NULL;
-    }
-    size_t offset = 0;
-#define ENSURE_CAP(extra) \
-    do { \
-        if (offset + (extra) >= new_capacity) { \
-            new_capacity = (offset + (extra)) * 2; \
-            char *tmp = realloc(new_content, new_capacity); \
-            if (!tmp) { free(new_content); free(formatted); return NULL; } \
-            new_content = tmp; \
-        } \
-    } while (0)
-    ENSURE_CAP(indent + 5);
-    for (int i = 0; i < indent; i++)
-        new_content[offset++] = ' ';
-    offset += snprintf(new_content+offset, new_capacity-offset, "\"\"\"\n");
-    char *saveptr;
-    char *line_ptr = strtok_r(formatted, "\n", &saveptr);
-    while (line_ptr) {
-        rtrim(line_ptr); // Remove trailing whitespace.
-        ENSURE_CAP(indent + strlen(line_ptr) + 5);
-        for (int i = 0; i < indent; i++)
-            new_content[offset++] = ' ';
-        offset += snprintf(new_content+offset, new_capacity-offset, "%s\n", line_ptr);
-        line_ptr = strtok_r(NULL, "\n", &saveptr);
-    }
-    ENSURE_CAP(indent + 5);
-    for (int i = 0; i < indent; i++)
-        new_content[offset++] = ' ';
-    offset += snprintf(new_content+offset, new_capacity-offset, "\"\"\"\n");
-    new_content[offset] = '\0';
-#undef ENSURE_CAP
-    free(formatted);
-    return new_content;
+    return formatted;
 }
 
-/* Rule B: Process an inline comment on a code line.
- * If a line contains code followed by an inline comment (i.e. '#' is not the first non-space)
- * and the total length exceeds MAX_LEN, split it into two lines:
- *   - The first line is the comment (moved above with "# " prefix and same indentation).
- *   - The second line is the code portion.
- * Returns a new string if modified, or NULL if no change is needed.
- */
-char *split_inline_comment(const char *original_line) {
-    char buffer[BUFFER_SIZE];
-    strncpy(buffer, original_line, BUFFER_SIZE-1);
-    buffer[BUFFER_SIZE-1] = '\0';
-    strip_crlf(buffer);
-    if (strlen(buffer) <= MAX_LEN)
-        return NULL;
-    char *hash_ptr = strchr(buffer, '#');
-    if (!hash_ptr)
-        return NULL;
-    const char *p = buffer;
-    while (*p && isspace((unsigned char)*p))
-        p++;
-    if (*p == '#')
-        return NULL;  // Already a full-line comment.
-    int code_len = hash_ptr - buffer;
-    char code_part[BUFFER_SIZE];
-    strncpy(code_part, buffer, code_len);
-    code_part[code_len] = '\0';
-    rtrim(code_part);
-    char *comment_part = hash_ptr;
-    if (*comment_part == '#')
-        comment_part++;
-    while (*comment_part && isspace((unsigned char)*comment_part))
-        comment_part++;
-    int indent = 0;
-    while (buffer[indent] && isspace((unsigned char)buffer[indent]))
-        indent++;
-    size_t new_capacity = BUFFER_SIZE;
-    char *new_content = malloc(new_capacity);
-    if (!new_content)
-        return NULL;
-    size_t offset = 0;
-#define ENSURE_SPLIT(extra) \
-    do { \
-        if (offset + (extra) >= new_capacity) { \
-            new_capacity = (offset + (extra)) * 2; \
-            char *tmp = realloc(new_content, new_capacity); \
-            if (!tmp) { free(new_content); return NULL; } \
-            new_content = tmp; \
-        } \
-    } while (0)
-    ENSURE_SPLIT(indent + strlen(comment_part) + 5);
-    for (int i = 0; i < indent; i++)
-        new_content[offset++] = ' ';
-    offset += snprintf(new_content+offset, new_capacity-offset, "# %s\n", comment_part);
-    ENSURE_SPLIT(strlen(code_part) + 5);
-    offset += snprintf(new_content+offset, new_capacity-offset, "%s\n", code_part);
-    new_content[offset] = '\0';
-#undef ENSURE_SPLIT
-    return new_content;
+// Snippet memo
+
+static struct memo_entry *memo_slot(struct snippet_memo *m, uint64_t hash, const char *snippet) {
+    size_t mask = m->capacity - 1;
+    size_t i = hash & mask;
+    while (m->slots[i].snippet && (m->slots[i].hash != hash || strcmp(m->slots[i].snippet, snippet) != 0))
+        i = (i + 1) & mask;
+    return &m->slots[i];
 }
 
-/* Rule C: Merge consecutive full-line comments into a single block.
- * Merges comment lines from index 'start' until the first non-comment line.
- * Flattens the merged content, rewraps it using wrap_text (available width = MAX_LEN - common_indent),
- * and encloses it in a triple-quoted block (""" ... """) with the common indentation.
- * Updates *end_index to the index after the merged block.
- */
-char *merge_comment_block(char **lines, size_t start, size_t count, size_t *end_index) {
-    int common_indent = 1000;
-    size_t i;
-    for (i = start; i < count; i++) {
-        const char *line = lines[i];
-        const char *p = line;
-        while (*p && isspace((unsigned char)*p))
-            p++;
-        if (*p != '#')
-            break;
-        int indent = p - line;
-        if (indent < common_indent)
-            common_indent = indent;
-    }
-    *end_index = i;
-    size_t merged_capacity = BUFFER_SIZE;
-    char *merged = malloc(merged_capacity);
-    if (!merged) return NULL;
-    merged[0] = '\0';
-    for (size_t j = start; j < i; j++) {
-        char *line = lines[j];
-        char *content = line + common_indent;
-        if (*content == '#') content++;
-        while (*content && isspace((unsigned char)*content))
-            content++;
-        size_t needed = strlen(content) + 2;
-        if (strlen(merged) + needed >= merged_capacity) {
-            merged_capacity = (strlen(merged) + needed) * 2;
-            char *tmp = realloc(merged, merged_capacity);
-            if (!tmp) { free(merged); return NULL; }
-            merged = tmp;
-        }
-        strcat(merged, content);
-        strcat(merged, " ");
-    }
-    rtrim(merged);
-    int avail_width = MAX_LEN - common_indent;
-    char *wrapped = wrap_text(merged, avail_width);
-    free(merged);
-    if (!wrapped)
-        return NULL;
-    // Remove any extra leading whitespace/newlines.
-    ltrim(wrapped);
-    size_t final_capacity = BUFFER_SIZE;
-    char *final_content = malloc(final_capacity);
-    if (!final_content) { free(wrapped); return NULL; }
-    size_t final_offset = 0;
-#define ENSURE_FINAL(extra) \
-    do { \
-        if (final_offset + (extra) >= final_capacity) { \
-            final_capacity = (final_offset + (extra)) * 2; \
-            char *tmp = realloc(final_content, final_capacity); \
-            if (!tmp) { free(final_content); free(wrapped); return NULL; } \
-            final_content = tmp; \
-        } \
-    } while (0)
-    ENSURE_FINAL(common_indent + 5);
-    for (int k = 0; k < common_indent; k++)
-        final_content[final_offset++] = ' ';
-    final_offset += snprintf(final_content+final_offset, final_capacity-final_offset, "\"\"\"\n");
-    char *saveptr;
-    char *token = strtok_r(wrapped, "\n", &saveptr);
-    while (token) {
-        rtrim(token); // trim trailing whitespace on each wrapped line.
-        ENSURE_FINAL(common_indent + strlen(token) + 5);
-        for (int k = 0; k < common_indent; k++)
-            final_content[final_offset++] = ' ';
-        final_offset += snprintf(final_content+final_offset, final_capacity-final_offset, "%s\n", token);
-        token = strtok_r(NULL, "\n", &saveptr);
+static bool memo_grow(struct snippet_memo *m) {
+    size_t old_capacity = m->capacity;
+    struct memo_entry *old = m->slots;
+    m->capacity = old_capacity ? old_capacity * 2 : 256;
+    m->slots = calloc(m->capacity, sizeof(struct memo_entry));
+    if (!m->slots) {
+        m->slots = old;
+        m->capacity = old_capacity;
+        return false;
     }
-    ENSURE_FINAL(common_indent + 5);
-    for (int k = 0; k < common_indent; k++)
-        final_content[final_offset++] = ' ';
-    final_offset += snprintf(final_content+final_offset, final_capacity-final_offset, "\"\"\"\n");
-    final_content[final_offset] = '\0';
-#undef ENSURE_FINAL
-    free(wrapped);
-    return final_content;
+    for (size_t i = 0; i < old_capacity; i++)
+        if (old[i].snippet)
+            *memo_slot(m, old[i].hash, old[i].snippet) = old[i];
+    free(old);
+    return true;
 }
 
-/* Rule D: Process an existing triple-quoted comment block.
- * If a line (after indentation) starts with """ then it is the beginning of a block.
- * The function gathers all lines until the closing """ is found, merges the inner content,
- * reflows it (using wrap_text with available width = MAX_LEN - common_indent),
- * trims trailing whitespace from each rewrapped line, and reassembles the block with opening
- * and closing triple quotes.
- * Updates *end_index to be the index after the block.
- */
-char *process_triple_quote_block(char **lines, size_t start, size_t count, size_t *end_index) {
-    const char *line = lines[start];
-    int common_indent = 0;
-    while (line[common_indent] && isspace((unsigned char)line[common_indent]))
-        common_indent++;
-    if (strstr(line, "\"\"\"") == NULL)
-        return NULL;
-    char *open_ptr = strstr(lines[start], "\"\"\"");
-    open_ptr += 3; // Skip the opening triple quotes.
-    size_t content_capacity = BUFFER_SIZE, content_total = 0;
-    char *content = malloc(content_capacity);
-    if (!content) return NULL;
-    content[0] = '\0';
-    if (*open_ptr) {
-        strcat(content, open_ptr);
-        strcat(content, " ");
-        content_total = strlen(content);
-    }
-    size_t i;
-    for (i = start + 1; i < count; i++) {
-        if (strstr(lines[i], "\"\"\"") != NULL) {
-            char *close_ptr = strstr(lines[i], "\"\"\"");
-            size_t len = close_ptr - lines[i];
-            char temp[BUFFER_SIZE];
-            strncpy(temp, lines[i], len);
-            temp[len] = '\0';
-            if (strlen(temp) > 0) {
-                if (content_total + strlen(temp) + 2 > content_capacity) {
-                    content_capacity = (content_total + strlen(temp) + 2) * 2;
-                    char *tmp = realloc(content, content_capacity);
-                    if (!tmp) { free(content); return NULL; }
-                    content = tmp;
-                }
-                strcat(content, temp);
-                strcat(content, " ");
-                content_total = strlen(content);
-            }
-            i++;
-            break;
-        } else {
-            char temp[BUFFER_SIZE];
-            strcpy(temp, lines[i]);
-            strip_crlf(temp);
-            if (content_total + strlen(temp) + 2 > content_capacity) {
-                content_capacity = (content_total + strlen(temp) + 2) * 2;
-                char *tmp = realloc(content, content_capacity);
-                if (!tmp) { free(content); return NULL; }
-                content = tmp;
-            }
-            strcat(content, temp);
-            strcat(content, " ");
-            content_total = strlen(content);
-        }
+/* memo_put()
+ * Records the result for a snippet (copying both). Caller holds the lock.
+ */
+static bool memo_put(struct snippet_memo *m, const char *snippet, const char *result) {
+    if ((m->used + 1) * 2 > m->capacity && !memo_grow(m))
+        return false;
+    uint64_t hash = xxh64(snippet, strlen(snippet), 0);
+    struct memo_entry *slot = memo_slot(m, hash, snippet);
+    if (slot->snippet)
+        return true;
+    char *s = strdup(snippet), *r = strdup(result);
+    if (!s || !r) {
+        free(s);
+        free(r);
+        return false;
     }
-    *end_index = i;
-    int avail_width = MAX_LEN - common_indent;
-    char *wrapped = wrap_text(content, avail_width);
-    free(content);
-    if (!wrapped)
-        return NULL;
-    ltrim(wrapped);
-    size_t final_capacity = BUFFER_SIZE;
-    char *final_block = malloc(final_capacity);
-    if (!final_block) { free(wrapped); return NULL; }
-    size_t final_offset = 0;
-#define ENSURE_FINAL(extra) \
-    do { \
-        if (final_offset + (extra) >= final_capacity) { \
-            final_capacity = (final_offset + (extra)) * 2; \
-            char *tmp = realloc(final_block, final_capacity); \
-            if (!tmp) { free(final_block); free(wrapped); return NULL; } \
-            final_block = tmp; \
-        } \
-    } while (0)
-    ENSURE_FINAL(common_indent + 5);
-    for (int k = 0; k < common_indent; k++)
-        final_block[final_offset++] = ' ';
-    final_offset += snprintf(final_block+final_offset, final_capacity-final_offset, "\"\"\"\n");
-    char *saveptr2;
-    char *token = strtok_r(wrapped, "\n", &saveptr2);
-    while (token) {
-        rtrim(token);
-        ENSURE_FINAL(common_indent + strlen(token) + 5);
-        for (int k = 0; k < common_indent; k++)
-            final_block[final_offset++] = ' ';
-        final_offset += snprintf(final_block+final_offset, final_capacity-final_offset, "%s\n", token);
-        token = strtok_r(NULL, "\n", &saveptr2);
-    }
-    ENSURE_FINAL(common_indent + 5);
-    for (int k = 0; k < common_indent; k++)
-        final_block[final_offset++] = ' ';
-    final_offset += snprintf(final_block+final_offset, final_capacity-final_offset, "\"\"\"\n");
-    final_block[final_offset] = '\0';
-#undef ENSURE_FINAL
-    free(wrapped);
-    return final_block;
+    slot->hash = hash;
+    slot->snippet = s;
+    slot->result = r;
+    m->used++;
+    m->dirty = true;
+    return true;
 }
 
-// ----------------- File/Directory Processing -----------------
-
-/* process_file()
- * Processes a single Python file by reading its lines into memory, applying the transformation rules,
- * and then writing the modified content back to the file.
+/* memo_lookup()
+ * Returns a newly allocated copy of the recorded result for 'snippet', or NULL if there is none.
  */
-void process_file(const char *filename) {
-    FILE *fin = fopen(filename, "r");
-    if (!fin) {
+static char *memo_lookup(struct snippet_memo *m, const char *snippet) {
+    uint64_t hash = xxh64(snippet, strlen(snippet), 0);
+    char *result = NULL;
+    pthread_mutex_lock(&m->lock);
+    if (m->used > 0) {
+        const struct memo_entry *e = memo_slot(m, hash, snippet);
+        if (e->snippet)
+            result = strdup(e->result);
+    }
+    pthread_mutex_unlock(&m->lock);
+    return result;
+}
+
+static void memo_insert(struct snippet_memo *m, const char *snippet, const char *result) {
+    pthread_mutex_lock(&m->lock);
+    memo_put(m, snippet, result);
+    pthread_mutex_unlock(&m->lock);
+}
+
+/* memo_open()
+ * Loads the memo stored in 'filename' and has memo_close() write it back there. A file written
+ * under another fingerprint (line length and Black version), or one that is missing or
+ * unreadable, gives an empty memo. Each record is a line with the snippet and result lengths,
+ * followed by the snippet and the result.
+ */
+void memo_open(struct snippet_memo *m, const char *filename, uint64_t fingerprint) {
+    snprintf(m->filename, sizeof(m->filename), "%s", filename);
+    m->fingerprint = fingerprint;
+    FILE *fp = fopen(filename, "r");
+    if (!fp)
+        return;
+    char *data = read_file_contents(fp);
+    fclose(fp);
+    unsigned long long stored;
+    int start = 0;
+    if (!data || sscanf(data, "reflow-snippets 1 %llx\n%n", &stored, &start) != 1 || start == 0 ||
+        stored != fingerprint) {
+        free(data);
+        m->dirty = true; // Rewrite it under the current fingerprint.
+        return;
+    }
+    size_t size = strlen(data), pos = (size_t)start;
+    pthread_mutex_lock(&m->lock);
+    while (pos < size) {
+        char *end;
+        unsigned long long snippet_len = strtoull(data + pos, &end, 10);
+        unsigned long long result_len = strtoull(end, &end, 10);
+        if (*end != '\n')
+            break;
+        size_t body = (size_t)(end - data) + 1;
+        if (snippet_len == 0 || snippet_len > size - body || result_len > size - body - snippet_len)
+            break;
+        char *snippet = strndup(data + body, snippet_len);
+        char *result = strndup(data + body + snippet_len, result_len);
+        bool ok = snippet && result && memo_put(m, snippet, result);
+        free(snippet);
+        free(result);
+        if (!ok)
+            break;
+        pos = body + snippet_len + result_len;
+    }
+    m->dirty = false;
+    pthread_mutex_unlock(&m->lock);
+    free(data);
+}
+
+/* memo_close()
+ * Writes the memo back (through a temporary file next to it) if it is stored and has new
+ * entries, and frees it.
+ */
+static void memo_close(struct snippet_memo *m) {
+    if (m->filename[0] && m->dirty) {
+        char tmp[BUFFER_SIZE + 16];
+        snprintf(tmp, sizeof(tmp), "%s.XXXXXX", m->filename);
+        int fd = mkstemp(tmp);
+        FILE *fp = (fd == -1) ? NULL : fdopen(fd, "w");
+        if (!fp) {
+            perror(m->filename);
+            if (fd != -1)
+                close(fd);
+        } else {
+            fprintf(fp, "reflow-snippets 1 %016llx\n", (unsigned long long)m->fingerprint);
+            for (size_t i = 0; i < m->capacity; i++) {
+                const struct memo_entry *e = &m->slots[i];
+                if (e->snippet)
+                    fprintf(fp, "%zu %zu\n%s%s", strlen(e->snippet), strlen(e->result), e->snippet, e->result);
+            }
+            if (fclose(fp) != 0 || rename(tmp, m->filename) != 0) {
+                perror(m->filename);
+                remove(tmp);
+            }
+        }
+    }
+    for (size_t i = 0; i < m->capacity; i++) {
+        free(m->slots[i].snippet);
+        free(m->slots[i].result);
+    }
+    free(m->slots);
+    m->slots = NULL;
+    m->capacity = m->used = 0;
+    m->filename[0] = '\0';
+}
+
+/* black_exchange()
+ * Sends one batch to a helper and reads back its answers. Returns false if the helper
+ * broke the protocol; results already stored stay valid.
+ */
+static bool black_exchange(struct black_helper *h, int width, char **snippets, size_t n,
+                           char **results) {
+    fprintf(h->to_helper, "BATCH %zu %d\n", n, width);
+    for (size_t i = 0; i < n; i++) {
+        size_t len = strlen(snippets[i]);
+        fprintf(h->to_helper, "%zu\n", len);
+        fwrite(snippets[i], 1, len, h->to_helper);
+    }
+    if (fflush(h->to_helper) != 0)
+        return false;
+    for (size_t i = 0; i < n; i++) {
+        char header[64];
+        size_t len;
+        char tag[4];
+        if (!fgets(header, sizeof(header), h->from_helper) ||
+            sscanf(header, "%3s %zu", tag, &len) != 2)
+            return false;
+        char *res = malloc(len + 1);
+        if (!res)
+            return false;
+        if (fread(res, 1, len, h->from_helper) != len) {
+            free(res);
+            return false;
+        }
+        res[len] = '\0';
+        if (strcmp(tag, "OK") == 0) {
+            results[i] = res;
+        } else {
+            free(res);
+            results[i] = NULL;
+        }
+    }
+    return true;
+}
+
+/* black_format()
+ * Formats n snippets: in the embedded interpreter, or in one round trip to helper 'h'. If there
+ * is no helper ('h' may be NULL) or it has died, the snippets go through the "black" command.
+ */
+static void black_format(struct black_backend *bb, struct black_helper *h, char **snippets, size_t n,
+                         char **results) {
+    for (size_t i = 0; i < n; i++)
+        results[i] = NULL;
+#ifdef REFLOW_EMBED_PYTHON
+    if (bb->embedded) {
+        black_embed_format(bb, snippets, n, results);
+        return;
+    }
+#endif
+    bool done = false;
+    if (h && h->pid > 0) {
+        done = black_exchange(h, bb->line_length, snippets, n, results);
+        if (!done) {
+            fprintf(stderr, "Warning: Black helper stopped responding; falling back to the black command.\n");
+            helper_stop(h);
+            for (size_t i = 0; i < n; i++) {
+                free(results[i]);
+                results[i] = NULL;
+            }
+        }
+    }
+    if (!done)
+        for (size_t i = 0; i < n; i++)
+            results[i] = format_with_black_cli(snippets[i], bb->line_length);
+}
+
+/* black_run_job()
+ * Formats the snippets of a job that the memo did not answer (those whose result is still
+ * NULL) and records the new results in the memo.
+ */
+static void black_run_job(struct black_backend *bb, struct black_helper *h, struct black_job *job) {
+    uint64_t t = now_ns();
+    char **snippets = job->snippets, **results = job->results;
+    size_t n = job->n;
+    char **missing = NULL;
+    if (job->hits > 0) {
+        missing = malloc(2 * (job->n - job->hits) * sizeof(char *));
+        if (!missing) {
+            perror("malloc");
+            job->ns = now_ns() - t;
+            return; // The missing results stay NULL.
+        }
+        n = 0;
+        for (size_t i = 0; i < job->n; i++)
+            if (!job->results[i])
+                missing[n++] = job->snippets[i];
+        snippets = missing;
+        results = missing + n;
+    }
+    black_format(bb, h, snippets, n, results);
+    for (size_t i = 0; i < n; i++)
+        if (results[i])
+            memo_insert(&bb->memo, snippets[i], results[i]);
+    if (missing) {
+        for (size_t i = 0, k = 0; i < job->n; i++)
+            if (!job->results[i])
+                job->results[i] = results[k++];
+        free(missing);
+    }
+    job->ns = now_ns() - t;
+}
+
+/* black_worker_main()
+ * Runs queued jobs until black_stop() is called and the queue is empty.
+ */
+static void *black_worker_main(void *arg) {
+    struct black_worker *w = arg;
+    struct black_backend *bb = w->bb;
+    pthread_mutex_lock(&bb->lock);
+    for (;;) {
+        while (!bb->head && !bb->stopping)
+            pthread_cond_wait(&bb->queued, &bb->lock);
+        struct black_job *job = bb->head;
+        if (!job)
+            break;
+        bb->head = job->next;
+        if (!bb->head)
+            bb->tail = NULL;
+        pthread_mutex_unlock(&bb->lock);
+        black_run_job(bb, &w->helper, job);
+        pthread_mutex_lock(&bb->lock);
+        job->done = true;
+        pthread_cond_broadcast(&bb->finished);
+    }
+    pthread_mutex_unlock(&bb->lock);
+    return NULL;
+}
+
+/* black_submit()
+ * Answers what it can of a job from the memo, then queues the rest for the next free worker and
+ * returns at once; black_wait() collects it. The job must stay in place until then. A job the
+ * memo answers completely, or any job without workers, is done before returning.
+ */
+void black_submit(struct black_backend *bb, struct black_job *job) {
+    job->done = false;
+    job->next = NULL;
+    job->ns = 0;
+    job->hits = 0;
+    for (size_t i = 0; i < job->n; i++)
+        if ((job->results[i] = memo_lookup(&bb->memo, job->snippets[i])) != NULL)
+            job->hits++;
+    if (job->hits == job->n) {
+        job->done = true;
+        return;
+    }
+    if (bb->nworkers == 0) {
+        black_run_job(bb, NULL, job);
+        job->done = true;
+        return;
+    }
+    pthread_mutex_lock(&bb->lock);
+    if (bb->tail)
+        bb->tail->next = job;
+    else
+        bb->head = job;
+    bb->tail = job;
+    pthread_cond_signal(&bb->queued);
+    pthread_mutex_unlock(&bb->lock);
+}
+
+/* black_wait()
+ * Blocks until a submitted job is done.
+ */
+void black_wait(struct black_backend *bb, struct black_job *job) {
+    pthread_mutex_lock(&bb->lock);
+    while (!job->done)
+        pthread_cond_wait(&bb->finished, &bb->lock);
+    pthread_mutex_unlock(&bb->lock);
+}
+
+/* black_format_batch()
+ * Formats n snippets with Black, storing a newly allocated result (or NULL on failure)
+ * in results[i]. The whole batch is one job and costs one round trip to a helper.
+ * Safe to call from several threads.
+ */
+void black_format_batch(struct black_backend *bb, char **snippets, size_t n, char **results) {
+    if (n == 0)
+        return;
+    struct black_job job = {.snippets = snippets, .results = results, .n = n};
+    black_submit(bb, &job);
+    black_wait(bb, &job);
+}
+
+// ----------------- Processing Rules -----------------
+
+/* Rule A, first half: extract the code of a commented-out print statement.
+ * If a full-line comment starts with "print(" (after '#' and whitespace) and the line exceeds 'width',
+ * returns the code with the '#' and spaces removed (as a newline-terminated snippet ready for Black,
+ * allocated from 'arena') and stores the line's indentation in *indent. Returns NULL otherwise.
+ */
+char *extract_commented_print(const char *line, size_t len, int width, int *indent,
+                              struct arena *arena) {
+    len = line_content_length(line, len);
+    if (len <= (size_t)width)
+        return NULL;
+    if (!is_commented_print(line, len))
+        return NULL;
+    const char *hash_ptr = memchr(line, '#', len);
+    if (!hash_ptr)
+        return NULL;
+    int code_len = hash_ptr - line;
+    if (code_len >= width)
+        return NULL;
+    size_t code = skip_space(line, code_len + 1, len);
+    if (len - code >= 4 && strncmp(line + code, "def ", 4) == 0)
+        return NULL;
+    *indent = (int)skip_space(line, 0, len);
+    size_t code_size = len - code;
+    char *snippet = arena_alloc(arena, code_size + 2);
+    if (!snippet)
+        return NULL;
+    memcpy(snippet, line + code, code_size);
+    snippet[code_size] = '\n';
+    snippet[code_size + 1] = '\0';
+    return snippet;
+}
+
+/* append_quoted_block()
+ * Appends 'text' as a triple-quoted block: the opening quotes, each of its lines with trailing
+ * whitespace trimmed, and the closing quotes, all indented by 'indent' spaces. The text is split
+ * in place. Returns false on allocation failure.
+ */
+bool append_quoted_block(struct strbuf *out, char *text, int indent) {
+    if (!strbuf_pad(out, ' ', indent) || !strbuf_append(out, "\"\"\"\n", 4))
+        return false;
+    char *saveptr;
+    char *token = strtok_r(text, "\n", &saveptr);
+    while (token) {
+        rtrim(token); // Remove trailing whitespace.
+        if (!strbuf_pad(out, ' ', indent) || !strbuf_append(out, token, strlen(token)) ||
+            !strbuf_append(out, "\n", 1))
+            return false;
+        token = strtok_r(NULL, "\n", &saveptr);
+    }
+    return strbuf_pad(out, ' ', indent) && strbuf_append(out, "\"\"\"\n", 4);
+}
+
+/* Rule A, second half: wrap Black's output in a triple-quoted block.
+ * Takes ownership of 'formatted' and returns the block (with trailing newline), indented by
+ * 'indent' spaces and allocated from 'arena', or NULL on allocation failure.
+ */
+char *build_print_block(char *formatted, int indent, struct arena *arena) {
+    strip_crlf(formatted);
+    if (formatted[0] == '#') {
+        memmove(formatted, formatted+1, strlen(formatted));
+        while (*formatted && isspace((unsigned char)*formatted))
+            memmove(formatted, formatted+1, strlen(formatted));
+    }
+    struct strbuf out = {.arena = arena};
+    bool ok = append_quoted_block(&out, formatted, indent);
+    free(formatted);
+    return ok ? out.data : NULL;
+}
+
+/* Rule A: Process a commented-out print statement.
+ * Formats a single line on its own: extracts the code, runs it through Black, and wraps the
+ * result in a triple-quoted block. process_file() uses the two halves directly so that all
+ * snippets of a file reach Black in one batch.
+ * Returns a string (with trailing newline) allocated from 'arena' if modified, or NULL otherwise.
+ */
+char *process_commented_print_line(const char *line, size_t len, struct black_backend *bb,
+                                   struct arena *arena) {
+    int indent;
+    char *code = extract_commented_print(line, len, bb->line_length, &indent, arena);
+    if (!code)
+        return NULL;
+    char *formatted;
+    black_format_batch(bb, &code, 1, &formatted);
+    if (!formatted) {
+        fprintf(stderr, "Error: Failed to run black. Ensure it is in your PATH.\n");
+        return NULL;
+    }
+    return build_print_block(formatted, indent, arena);
+}
+
+/* Rule B: Process an inline comment on a code line.
+ * If line i contains code followed by an inline comment (i.e. the comment the tokenizer found
+ * does not start at the indentation) and the total length exceeds the width, split it into two lines:
+ *   - The first line is the comment (moved above with "# " prefix and same indentation).
+ *   - The second line is the code portion.
+ * A '#' inside a string literal is not a comment, and lines that start inside a multi-line
+ * string are left alone, since moving their comment up would put it into the string.
+ * Returns a new string allocated from 'arena' if modified, or NULL if no change is needed.
+ */
+char *split_inline_comment(const struct source *src, size_t i, struct arena *arena) {
+    const struct line_span *span = &src->lines[i];
+    if (!(span->flags & LINE_HASH) || (span->flags & (LINE_COMMENT | LINE_IN_STRING)))
+        return NULL;
+    const char *line = src->data + span->off;
+    size_t len = line_content_length(line, span->len);
+    if (len <= (size_t)src->width)
+        return NULL;
+    size_t p = span->indent;
+    size_t code_len = span->comment;
+    while (code_len > 0 && isspace((unsigned char)line[code_len-1]))
+        code_len--;
+    size_t comment = skip_space(line, span->comment + 1, len);
+    struct strbuf out = {.arena = arena};
+    if (!strbuf_reserve(&out, p + (len - comment) + code_len + 4) ||
+        !strbuf_pad(&out, ' ', p) || !strbuf_append(&out, "# ", 2) ||
+        !strbuf_append(&out, line + comment, len - comment) || !strbuf_append(&out, "\n", 1) ||
+        !strbuf_append(&out, line, code_len) || !strbuf_append(&out, "\n", 1))
+        return NULL;
+    return out.data;
+}
+
+/* gather_begin()
+ * Prepares 'sb' for gathering lines [start, end) of src with strbuf_append_piece(): the lines
+ * are contiguous in the source, so their size is known from the spans at once, and one
+ * reservation (each line plus its separating space) means no append has to grow the buffer.
+ */
+static bool gather_begin(struct strbuf *sb, const struct source *src, size_t start, size_t end) {
+    size_t bytes = 0;
+    if (end > start)
+        bytes = src->lines[end - 1].off + src->lines[end - 1].len - src->lines[start].off;
+    return strbuf_reserve(sb, bytes + (end - start));
+}
+
+/* strbuf_trim_end()
+ * Drops trailing whitespace by length, without rescanning the buffer.
+ */
+static void strbuf_trim_end(struct strbuf *sb) {
+    while (sb->len > 0 && isspace((unsigned char)sb->data[sb->len - 1]))
+        sb->len--;
+    sb->data[sb->len] = '\0';
+}
+
+/* gather_comment_run()
+ * Gathers the full-line comments [start, end) of src into 'sb' as one paragraph for Rule C:
+ * each line without its first 'indent' columns, its '#' and the spaces after it. Trailing
+ * whitespace is trimmed. Returns false on allocation failure.
+ */
+static bool gather_comment_run(struct strbuf *sb, const struct source *src, size_t start,
+                               size_t end, int indent) {
+    if (!gather_begin(sb, src, start, end))
+        return false;
+    for (size_t j = start; j < end; j++) {
+        const char *line = src->data + src->lines[j].off;
+        size_t len = src->lines[j].len;
+        size_t content = indent;
+        if (content < len && line[content] == '#') content++;
+        content = skip_space(line, content, len);
+        if (!strbuf_append_piece(sb, line + content, len - content))
+            return false;
+    }
+    strbuf_trim_end(sb);
+    return true;
+}
+
+/* gather_quoted_block()
+ * Gathers the text of the triple-quoted block opening on line 'start' of src (which must be
+ * marked LINE_TQ_OPEN) into 'sb' as one paragraph for Rule D, up to the line the tokenizer
+ * marked as closing it. Sets *end_index to the index after the block. Returns false on
+ * allocation failure.
+ */
+static bool gather_quoted_block(struct strbuf *sb, const struct source *src, size_t start,
+                                size_t *end_index) {
+    const struct line_span *span = &src->lines[start];
+    const char *line = src->data + span->off;
+    const char *open_ptr = line + span->indent + 3; // Skip the opening triple quotes.
+    size_t open_len = span->len - (open_ptr - line);
+    // The tokenizer found the closing line; only the flags are needed to get there.
+    size_t close = start + 1;
+    while (close < src->count && !(src->lines[close].flags & LINE_TQ))
+        close++;
+    if (!gather_begin(sb, src, start, close < src->count ? close + 1 : close))
+        return false;
+    if (open_len > 0 && !strbuf_append_piece(sb, open_ptr, open_len))
+        return false;
+    size_t i;
+    for (i = start + 1; i < src->count; i++) {
+        const char *cur = src->data + src->lines[i].off;
+        size_t len = src->lines[i].len;
+        if (src->lines[i].flags & LINE_TQ) {
+            const char *close_ptr = cur + src->lines[i].tq_close;
+            if (close_ptr > cur && !strbuf_append_piece(sb, cur, close_ptr - cur))
+                return false;
+            i++;
+            break;
+        }
+        if (!strbuf_append_piece(sb, cur, line_content_length(cur, len)))
+            return false;
+    }
+    *end_index = i;
+    return true;
+}
+
+/* wrap_block()
+ * Wraps gathered block text for 'width' columns the way src's rules are set to wrap.
+ */
+static bool wrap_block(const struct source *src, struct strbuf *out, const char *text, size_t len,
+                       int width) {
+    if (src->wrap == WRAP_OPTIMAL)
+        return wrap_text_optimal_into(out, text, len, width);
+    return wrap_text_into(out, text, len, width);
+}
+
+/* span_is()
+ * Returns true if line i of src is exactly 'indent' spaces, the n bytes at s and a '\n'.
+ */
+static bool span_is(const struct source *src, size_t i, int indent, const char *s, size_t n) {
+    const struct line_span *span = &src->lines[i];
+    const char *line = src->data + span->off;
+    if (span->len != (size_t)indent + n + 1 || line[span->len - 1] != '\n')
+        return false;
+    for (int k = 0; k < indent; k++)
+        if (line[k] != ' ')
+            return false;
+    return memcmp(line + indent, s, n) == 0;
+}
+
+/* quoted_block_matches()
+ * Returns true if lines [start, end) of src already are what append_quoted_block() would make
+ * of 'text' with 'indent', so that a block in canonical form is left alone without building
+ * its replacement. Compares against the spans in place, one line at a time.
+ */
+static bool quoted_block_matches(const struct source *src, size_t start, size_t end,
+                                 const char *text, int indent) {
+    size_t i = start;
+    if (i >= end || !span_is(src, i++, indent, "\"\"\"", 3))
+        return false;
+    const char *p = text;
+    while (*p) {
+        const char *nl = strchr(p, '\n');
+        size_t n = nl ? (size_t)(nl - p) : strlen(p);
+        const char *next = p + n + (nl != NULL);
+        if (n == 0) {  // append_quoted_block() skips empty lines.
+            p = next;
+            continue;
+        }
+        while (n > 0 && isspace((unsigned char)p[n - 1]))
+            n--;
+        if (i >= end || !span_is(src, i++, indent, p, n))
+            return false;
+        p = next;
+    }
+    return i + 1 == end && span_is(src, i, indent, "\"\"\"", 3);
+}
+
+/* Rule C: Merge consecutive full-line comments into a single block.
+ * Merges comment lines from index 'start' until the first line the tokenizer did not mark as a
+ * full-line comment.
+ * Flattens the merged content, rewraps it using wrap_block (available width = width - common_indent),
+ * and encloses it in a triple-quoted block (""" ... """) with the common indentation.
+ * The block and all intermediate buffers are allocated from 'arena'.
+ * Updates *end_index to the index after the merged block.
+ */
+char *merge_comment_block(const struct source *src, size_t start, size_t *end_index,
+                          struct arena *arena) {
+    int common_indent = 1000;
+    size_t i;
+    for (i = start; i < src->count && (src->lines[i].flags & LINE_COMMENT); i++) {
+        int indent = (int)src->lines[i].indent;
+        if (indent < common_indent)
+            common_indent = indent;
+    }
+    *end_index = i;
+    struct strbuf merged = {.arena = arena};
+    if (!gather_comment_run(&merged, src, start, i, common_indent))
+        return NULL;
+    int avail_width = src->width - common_indent;
+    struct strbuf wrapped = {.arena = arena};
+    if (!wrap_block(src, &wrapped, merged.data, merged.len, avail_width))
+        return NULL;
+    // Remove any extra leading whitespace/newlines.
+    ltrim(wrapped.data);
+    struct strbuf out = {.arena = arena};
+    if (!append_quoted_block(&out, wrapped.data, common_indent))
+        return NULL;
+    return out.data;
+}
+
+/* Rule D: Process an existing triple-quoted comment block.
+ * Line 'start' must be marked LINE_TQ_OPEN: a """ string starts at its indentation and closes,
+ * with nothing after it, on a later line. The function gathers the lines up to the one the
+ * tokenizer marked as closing it (LINE_TQ), merges the inner content,
+ * reflows it (using wrap_block with available width = width - common_indent),
+ * trims trailing whitespace from each rewrapped line, and reassembles the block with opening
+ * and closing triple quotes. The block and all intermediate buffers are allocated from 'arena'.
+ * Updates *end_index to be the index after the block. Returns NULL, like a rule that does not
+ * apply, if the block is already exactly what it would be rewritten to.
+ */
+char *process_triple_quote_block(const struct source *src, size_t start, size_t *end_index,
+                                 struct arena *arena) {
+    const struct line_span *span = &src->lines[start];
+    if (!(span->flags & LINE_TQ_OPEN))
+        return NULL;
+    int common_indent = (int)span->indent;
+    struct strbuf content = {.arena = arena};
+    size_t i;
+    if (!gather_quoted_block(&content, src, start, &i))
+        return NULL;
+    *end_index = i;
+    int avail_width = src->width - common_indent;
+    struct strbuf wrapped = {.arena = arena};
+    if (!wrap_block(src, &wrapped, content.data, content.len, avail_width))
+        return NULL;
+    ltrim(wrapped.data);
+    if (quoted_block_matches(src, start, i, wrapped.data, common_indent))
+        return NULL;
+    struct strbuf out = {.arena = arena};
+    if (!append_quoted_block(&out, wrapped.data, common_indent))
+        return NULL;
+    return out.data;
+}
+
+// ----------------- Source Loading -----------------
+
+#define NO_LINE SIZE_MAX
+
+/* struct token_state
+ * Tokenizer state carried from one line to the next: the string literal still open at the end
+ * of the previous line, if any.
+ */
+struct token_state {
+    char quote;     /* its quote character, or 0 */
+    bool triple;
+    size_t opener;  /* line of a """ string that started at the indentation, or NO_LINE */
+};
+
+#define TOKEN_STATE_INIT {0, false, NO_LINE}
+
+/* string_end()
+ * Finds the end of a string literal whose body starts at line[i]. Backslash escapes are honored
+ * (raw strings cannot end on an escaped quote either). Returns the offset just past the closing
+ * quote(s), or NO_LINE if the literal continues on the next line: always for an unclosed triple
+ * quote, and for a single-quoted literal only after a backslash before the line break. Any other
+ * unclosed literal ends with its line.
+ */
+static size_t string_end(const char *line, size_t len, size_t i, char quote, bool triple) {
+    while (i < len) {
+        char c = line[i];
+        if (c == '\\') {
+            if (!triple && i + 1 < len && (line[i+1] == '\n' || line[i+1] == '\r'))
+                return NO_LINE;
+            i += 2;
+            continue;
+        }
+        if (c == quote && (!triple || (i + 2 < len && line[i+1] == quote && line[i+2] == quote)))
+            return i + (triple ? 3 : 1);
+        i++;
+    }
+    return triple ? NO_LINE : len;
+}
+
+/* tokenize_line()
+ * Classifies line idx of src given the state left by the line before it, and updates the state
+ * for the next line. 'raw' holds the LINE_HASH/LINE_QUOTE bits of the raw bytes; a line with
+ * neither that does not start inside a string is plain code and is not looked at again. Fills
+ * in the span's indent, comment and tq_close offsets and its LINE_* flags. When a standalone """
+ * string closes, its opening line gets LINE_TQ_OPEN. Keeps src->candidates up to date.
+ */
+static void tokenize_line(struct token_state *ts, struct source *src, size_t idx, unsigned raw) {
+    struct line_span *span = &src->lines[idx];
+    const char *line = src->data + span->off;
+    size_t len = span->len;
+    unsigned flags = (raw & LINE_QUOTE) | ((len > (size_t)src->width) ? LINE_LONG : 0);
+    size_t indent = skip_space(line, 0, len);
+    span->indent = (uint32_t)indent;
+    span->comment = span->tq_close = NO_OFFSET;
+    size_t i = 0;
+    if (ts->quote) {
+        flags |= LINE_IN_STRING;
+        i = string_end(line, len, 0, ts->quote, ts->triple);
+        if (i == NO_LINE) {
+            span->flags = flags;
+            return;
+        }
+        if (ts->triple && ts->quote == '"') {
+            flags |= LINE_TQ;
+            span->tq_close = (uint32_t)(i - 3);
+            // Rule D only rewrites a block that nothing follows on its closing line.
+            if (ts->opener != NO_LINE && skip_space(line, i, len) == len) {
+                src->lines[ts->opener].flags |= LINE_TQ_OPEN;
+                if (!LINE_IS_CANDIDATE(src->lines[ts->opener].flags & ~LINE_TQ_OPEN))
+                    src->candidates++;
+            }
+        }
+        ts->quote = 0;
+        ts->opener = NO_LINE;
+    } else if (!(raw & (LINE_HASH | LINE_QUOTE))) {
+        span->flags = flags;
+        if (LINE_IS_CANDIDATE(flags))
+            src->candidates++;
+        return;
+    }
+    for (; i < len; i++) {
+        char c = line[i];
+        if (c == '#') {
+            flags |= LINE_HASH;
+            span->comment = (uint32_t)i;
+            if (i == indent)
+                flags |= LINE_COMMENT;
+            break;
+        }
+        if (c != '"' && c != '\'')
+            continue;
+        bool triple = i + 2 < len && line[i+1] == c && line[i+2] == c;
+        size_t end = string_end(line, len, i + (triple ? 3 : 1), c, triple);
+        if (end == NO_LINE) {
+            ts->quote = c;
+            ts->triple = triple;
+            if (triple && c == '"' && i == indent) {
+                flags |= LINE_TQ_START;
+                ts->opener = idx;
+            }
+            break;
+        }
+        i = end - 1;
+    }
+    span->flags = flags;
+    if (LINE_IS_CANDIDATE(flags))
+        src->candidates++;
+}
+
+/* raw_line_flags()
+ * The LINE_HASH/LINE_QUOTE bits tokenize_line() expects, for lines not indexed by scan_source().
+ */
+static unsigned raw_line_flags(const char *line, size_t len) {
+    unsigned raw = 0;
+    if (memchr(line, '#', len))
+        raw |= LINE_HASH;
+    if (memchr(line, '"', len) || memchr(line, '\'', len))
+        raw |= LINE_QUOTE;
+    return raw;
+}
+
+/* struct scan_state
+ * Line currently being built by scan_source().
+ */
+struct scan_state {
+    struct source *src;
+    size_t capacity;
+    size_t line_start;
+    unsigned flags;
+    struct token_state tok;
+};
+
+static bool scan_end_line(struct scan_state *ss, size_t end) {
+    struct source *src = ss->src;
+    if (src->count >= ss->capacity) {
+        size_t capacity = (ss->capacity == 0) ? 256 : ss->capacity * 2;
+        struct line_span *tmp = realloc(src->lines, capacity * sizeof(struct line_span));
+        if (!tmp)
+            return false;
+        src->lines = tmp;
+        ss->capacity = capacity;
+    }
+    struct line_span *span = &src->lines[src->count++];
+    span->off = ss->line_start;
+    span->len = end - ss->line_start;
+    tokenize_line(&ss->tok, src, src->count - 1, ss->flags);
+    ss->line_start = end;
+    ss->flags = 0;
+    return true;
+}
+
+/* scan_events()
+ * Handles one block of the scan: bit k of each mask is set when byte base+k is a newline,
+ * '#' or a quote character. Blocks with none of them (the common case) cost nothing beyond
+ * the compares.
+ */
+static bool scan_events(struct scan_state *ss, size_t base, uint32_t nl, uint32_t hash, uint32_t quote) {
+    uint32_t events = nl | hash | quote;
+    while (events) {
+        int k = __builtin_ctz(events);
+        uint32_t bit = 1u << k;
+        if (hash & bit)
+            ss->flags |= LINE_HASH;
+        else if (quote & bit)
+            ss->flags |= LINE_QUOTE;
+        else if (!scan_end_line(ss, base + k + 1))
+            return false;
+        events &= events - 1;
+    }
+    return true;
+}
+
+#if defined(__ARM_NEON) && !defined(__AVX2__) && !defined(__SSE2__)
+static uint32_t neon_movemask(uint8x16_t v) {
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t m = vandq_u8(v, vld1q_u8(weights));
+    uint8x8_t lo = vget_low_u8(m), hi = vget_high_u8(m);
+    for (int k = 0; k < 3; k++) {
+        lo = vpadd_u8(lo, lo);
+        hi = vpadd_u8(hi, hi);
+    }
+    return vget_lane_u8(lo, 0) | ((uint32_t)vget_lane_u8(hi, 0) << 8);
+}
+#endif
+
+/* scan_source()
+ * Builds the line index of src->data in one vectorized pass (AVX2, SSE2 or NEON, whichever the
+ * build targets, with a scalar tail) that finds newlines, '#' and quote characters at once.
+ * Every finished line goes through tokenize_line(), which gives each span its LINE_* flags and
+ * offsets, and src->candidates counts the lines any rule could apply to.
+ * Returns -1 on allocation failure.
+ */
+static int scan_source(struct source *src) {
+    struct scan_state ss = {src, 0, 0, 0, TOKEN_STATE_INIT};
+    const unsigned char *data = (const unsigned char *)src->data;
+    size_t size = src->size, i = 0;
+    src->count = src->candidates = 0;
+    if (size / 32 > 0) {
+        ss.capacity = size / 32;
+        src->lines = malloc(ss.capacity * sizeof(struct line_span));
+        if (!src->lines)
+            return -1;
+    }
+#if defined(__AVX2__)
+    const __m256i v_nl = _mm256_set1_epi8('\n'), v_hash = _mm256_set1_epi8('#'),
+                  v_quote = _mm256_set1_epi8('"'), v_squote = _mm256_set1_epi8('\'');
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + i));
+        uint32_t nl = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, v_nl));
+        uint32_t hash = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, v_hash));
+        uint32_t quote = (uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, v_quote), _mm256_cmpeq_epi8(v, v_squote)));
+        if ((nl | hash | quote) && !scan_events(&ss, i, nl, hash, quote))
+            return -1;
+    }
+#elif defined(__SSE2__)
+    const __m128i v_nl = _mm_set1_epi8('\n'), v_hash = _mm_set1_epi8('#'), v_quote = _mm_set1_epi8('"'),
+                  v_squote = _mm_set1_epi8('\'');
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+        uint32_t nl = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, v_nl));
+        uint32_t hash = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, v_hash));
+        uint32_t quote = (uint32_t)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, v_quote), _mm_cmpeq_epi8(v, v_squote)));
+        if ((nl | hash | quote) && !scan_events(&ss, i, nl, hash, quote))
+            return -1;
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t v_nl = vdupq_n_u8('\n'), v_hash = vdupq_n_u8('#'), v_quote = vdupq_n_u8('"'),
+                     v_squote = vdupq_n_u8('\'');
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v = vld1q_u8(data + i);
+        uint32_t nl = neon_movemask(vceqq_u8(v, v_nl));
+        uint32_t hash = neon_movemask(vceqq_u8(v, v_hash));
+        uint32_t quote = neon_movemask(vorrq_u8(vceqq_u8(v, v_quote), vceqq_u8(v, v_squote)));
+        if ((nl | hash | quote) && !scan_events(&ss, i, nl, hash, quote))
+            return -1;
+    }
+#endif
+    for (; i < size; i++) {
+        if (data[i] == '#')
+            ss.flags |= LINE_HASH;
+        else if (data[i] == '"' || data[i] == '\'')
+            ss.flags |= LINE_QUOTE;
+        else if (data[i] == '\n' && !scan_end_line(&ss, i + 1))
+            return -1;
+    }
+    if (ss.line_start < size && !scan_end_line(&ss, size))
+        return -1;
+    return 0;
+}
+
+/* read_fd_contents()
+ * Reads everything from fd into a newly allocated buffer, for inputs that cannot be mapped.
+ */
+static char *read_fd_contents(int fd, size_t *size) {
+    size_t capacity = BUFFER_SIZE, total = 0;
+    char *data = malloc(capacity);
+    if (!data)
+        return NULL;
+    for (;;) {
+        if (total == capacity) {
+            capacity *= 2;
+            char *tmp = realloc(data, capacity);
+            if (!tmp) {
+                free(data);
+                return NULL;
+            }
+            data = tmp;
+        }
+        ssize_t n = read(fd, data + total, capacity - total);
+        if (n < 0) {
+            free(data);
+            return NULL;
+        }
+        if (n == 0)
+            break;
+        total += n;
+    }
+    *size = total;
+    return data;
+}
+
+/* load_source()
+ * Maps a file read-only (falling back to reading it when it cannot be mapped) and indexes
+ * its lines with scan_source() for rules enforcing 'width'. Lines of any length are kept whole.
+ * Returns 0 on success, -1 on error.
+ */
+int load_source(const char *filename, int width, struct source *src) {
+    memset(src, 0, sizeof(*src));
+    src->fd = -1;
+    src->width = width;
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        perror(filename);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        perror(filename);
+        close(fd);
+        return -1;
+    }
+    if (S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+#endif
+            src->data = map;
+            src->size = st.st_size;
+            src->mapped = true;
+        }
+    }
+    if (!src->mapped) {
+        char *data = read_fd_contents(fd, &src->size);
+        if (!data) {
+            perror(filename);
+            close(fd);
+            return -1;
+        }
+        src->data = data;
+    }
+    src->fd = fd;
+    if (scan_source(src) != 0) {
+        perror("realloc");
+        free_source(src);
+        return -1;
+    }
+    return 0;
+}
+
+/* free_source()
+ * Releases the mapping (or buffer) and the line index of a source.
+ */
+void free_source(struct source *src) {
+    if (src->fd >= 0)
+        close(src->fd);
+    if (src->mapped)
+        munmap((void *)src->data, src->size);
+    else
+        free((void *)src->data);
+    free(src->lines);
+    memset(src, 0, sizeof(*src));
+    src->fd = -1;
+}
+
+// ----------------- Content-Hash Cache -----------------
+
+/* xxh64()
+ * XXH64 hash of len bytes at data. Fast enough that hashing a mapped file costs far less
+ * than running the rules over it.
+ */
+static const uint64_t XXH_P1 = 0x9E3779B185EBCA87ULL, XXH_P2 = 0xC2B2AE3D27D4EB4FULL,
+                      XXH_P3 = 0x165667B19E3779F9ULL, XXH_P4 = 0x85EBCA77C2B2AE63ULL,
+                      XXH_P5 = 0x27D4EB2F165667C5ULL;
+
+static uint64_t xxh_rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static uint64_t xxh_read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static uint32_t xxh_read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint64_t xxh_round(uint64_t acc, uint64_t input) {
+    acc += input * XXH_P2;
+    return xxh_rotl(acc, 31) * XXH_P1;
+}
+
+static uint64_t xxh_merge(uint64_t acc, uint64_t val) {
+    acc ^= xxh_round(0, val);
+    return acc * XXH_P1 + XXH_P4;
+}
+
+uint64_t xxh64(const void *data, size_t len, uint64_t seed) {
+    const unsigned char *p = data, *end = p + len;
+    uint64_t h;
+    if (len >= 32) {
+        uint64_t v1 = seed + XXH_P1 + XXH_P2, v2 = seed + XXH_P2, v3 = seed, v4 = seed - XXH_P1;
+        do {
+            v1 = xxh_round(v1, xxh_read64(p));
+            v2 = xxh_round(v2, xxh_read64(p + 8));
+            v3 = xxh_round(v3, xxh_read64(p + 16));
+            v4 = xxh_round(v4, xxh_read64(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+        h = xxh_rotl(v1, 1) + xxh_rotl(v2, 7) + xxh_rotl(v3, 12) + xxh_rotl(v4, 18);
+        h = xxh_merge(h, v1);
+        h = xxh_merge(h, v2);
+        h = xxh_merge(h, v3);
+        h = xxh_merge(h, v4);
+    } else {
+        h = seed + XXH_P5;
+    }
+    h += (uint64_t)len;
+    for (; end - p >= 8; p += 8)
+        h = xxh_rotl(h ^ xxh_round(0, xxh_read64(p)), 27) * XXH_P1 + XXH_P4;
+    if (end - p >= 4) {
+        h = xxh_rotl(h ^ (xxh_read32(p) * XXH_P1), 23) * XXH_P2 + XXH_P3;
+        p += 4;
+    }
+    for (; p < end; p++)
+        h = xxh_rotl(h ^ (*p * XXH_P5), 11) * XXH_P1;
+    h ^= h >> 33;
+    h *= XXH_P2;
+    h ^= h >> 29;
+    h *= XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+/* struct cache_entry
+ * What the cache knows about one file: the hash of content that needed no changes, and the
+ * size and mtime the file had then. An mtime of 0 means the stat data cannot be trusted and
+ * the content has to be hashed again.
+ */
+struct cache_entry {
+    char *path; /* relative to the cache's root directory; NULL for an empty slot */
+    uint64_t hash;
+    long long size, mtime_sec, mtime_nsec;
+};
+
+/* struct file_cache
+ * Persistent record of files known not to need any changes, keyed by path, the content hash
+ * and a fingerprint of the settings they were checked with. Stored as text in 'filename'.
+ */
+struct file_cache {
+    pthread_mutex_t lock;
+    char filename[BUFFER_SIZE];
+    char root[BUFFER_SIZE];
+    uint64_t fingerprint;
+    struct cache_entry *slots; /* open addressing, capacity is a power of two */
+    size_t capacity, used;
+    bool dirty;
+};
+
+static struct cache_entry *cache_slot(struct file_cache *fc, const char *path) {
+    size_t mask = fc->capacity - 1;
+    size_t i = xxh64(path, strlen(path), 0) & mask;
+    while (fc->slots[i].path && strcmp(fc->slots[i].path, path) != 0)
+        i = (i + 1) & mask;
+    return &fc->slots[i];
+}
+
+static bool cache_grow(struct file_cache *fc) {
+    size_t old_capacity = fc->capacity;
+    struct cache_entry *old = fc->slots;
+    fc->capacity = old_capacity ? old_capacity * 2 : 1024;
+    fc->slots = calloc(fc->capacity, sizeof(struct cache_entry));
+    if (!fc->slots) {
+        fc->slots = old;
+        fc->capacity = old_capacity;
+        return false;
+    }
+    for (size_t i = 0; i < old_capacity; i++)
+        if (old[i].path)
+            *cache_slot(fc, old[i].path) = old[i];
+    free(old);
+    return true;
+}
+
+/* cache_put()
+ * Inserts or replaces the entry for e->path (copying the path). Caller holds the lock.
+ */
+static bool cache_put(struct file_cache *fc, const struct cache_entry *e) {
+    if ((fc->used + 1) * 2 > fc->capacity && !cache_grow(fc))
+        return false;
+    struct cache_entry *slot = cache_slot(fc, e->path);
+    if (!slot->path) {
+        slot->path = strdup(e->path);
+        if (!slot->path)
+            return false;
+        fc->used++;
+    }
+    slot->hash = e->hash;
+    slot->size = e->size;
+    slot->mtime_sec = e->mtime_sec;
+    slot->mtime_nsec = e->mtime_nsec;
+    return true;
+}
+
+/* cache_open()
+ * Loads the cache stored in 'filename' for files below 'root'. Entries recorded under a
+ * different settings fingerprint are discarded. A missing or unreadable file gives an empty
+ * cache; an empty filename one that is only kept in memory. Returns false only on allocation
+ * failure.
+ */
+bool cache_open(struct file_cache *fc, const char *filename, const char *root, uint64_t fingerprint) {
+    memset(fc, 0, sizeof(*fc));
+    pthread_mutex_init(&fc->lock, NULL);
+    snprintf(fc->filename, sizeof(fc->filename), "%s", filename);
+    snprintf(fc->root, sizeof(fc->root), "%s", root);
+    fc->fingerprint = fingerprint;
+    if (!cache_grow(fc))
+        return false;
+    FILE *fp = fopen(filename, "r");
+    if (!fp)
+        return true;
+    char line[2 * BUFFER_SIZE];
+    unsigned long long stored;
+    if (!fgets(line, sizeof(line), fp) || sscanf(line, "reflow-cache 1 %llx", &stored) != 1 ||
+        stored != fingerprint) {
+        fclose(fp);
+        fc->dirty = true; // Rewrite it under the current fingerprint.
+        return true;
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        strip_crlf(line);
+        struct cache_entry e;
+        unsigned long long hash;
+        int path_start;
+        if (sscanf(line, "%llx %lld %lld %lld %n", &hash, &e.size, &e.mtime_sec, &e.mtime_nsec,
+                   &path_start) != 4 || !line[path_start])
+            continue;
+        e.hash = hash;
+        e.path = line + path_start;
+        if (!cache_put(fc, &e)) {
+            fclose(fp);
+            return false;
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+/* cache_close()
+ * Writes the cache back (through a temporary file next to it) if it changed, and frees it.
+ */
+void cache_close(struct file_cache *fc) {
+    if (fc->dirty && fc->filename[0]) {
+        char tmp[BUFFER_SIZE + 16];
+        snprintf(tmp, sizeof(tmp), "%s.XXXXXX", fc->filename);
+        int fd = mkstemp(tmp);
+        FILE *fp = (fd == -1) ? NULL : fdopen(fd, "w");
+        if (!fp) {
+            perror(fc->filename);
+            if (fd != -1)
+                close(fd);
+        } else {
+            fprintf(fp, "reflow-cache 1 %016llx\n", (unsigned long long)fc->fingerprint);
+            for (size_t i = 0; i < fc->capacity; i++) {
+                const struct cache_entry *e = &fc->slots[i];
+                if (e->path)
+                    fprintf(fp, "%016llx %lld %lld %lld %s\n", (unsigned long long)e->hash, e->size,
+                            e->mtime_sec, e->mtime_nsec, e->path);
+            }
+            if (fclose(fp) != 0 || rename(tmp, fc->filename) != 0) {
+                perror(fc->filename);
+                remove(tmp);
+            }
+        }
+    }
+    for (size_t i = 0; i < fc->capacity; i++)
+        free(fc->slots[i].path);
+    free(fc->slots);
+    pthread_mutex_destroy(&fc->lock);
+}
+
+/* cache_key()
+ * Returns the part of 'path' below the cache's root, which is what entries are keyed by.
+ */
+static const char *cache_key(const struct file_cache *fc, const char *path) {
+    size_t n = strlen(fc->root);
+    if (n > 0 && strncmp(path, fc->root, n) == 0 && path[n] == '/')
+        return path + n + 1;
+    return path;
+}
+
+/* cache_stat_matches()
+ * Returns true if the file is recorded as clean and its size and mtime are unchanged since,
+ * so it can be skipped without being opened.
+ */
+bool cache_stat_matches(struct file_cache *fc, const char *path, const struct stat *st) {
+    const char *key = cache_key(fc, path);
+    pthread_mutex_lock(&fc->lock);
+    const struct cache_entry *e = cache_slot(fc, key);
+    bool match = e->path && e->mtime_sec != 0 && e->size == (long long)st->st_size &&
+                 e->mtime_sec == (long long)st->st_mtim.tv_sec &&
+                 e->mtime_nsec == (long long)st->st_mtim.tv_nsec;
+    pthread_mutex_unlock(&fc->lock);
+    return match;
+}
+
+/* cache_hash_matches()
+ * Returns true if content with this hash is recorded as clean for the file.
+ */
+bool cache_hash_matches(struct file_cache *fc, const char *path, uint64_t hash) {
+    const char *key = cache_key(fc, path);
+    pthread_mutex_lock(&fc->lock);
+    const struct cache_entry *e = cache_slot(fc, key);
+    bool match = e->path && e->hash == hash;
+    pthread_mutex_unlock(&fc->lock);
+    return match;
+}
+
+/* cache_mark_clean()
+ * Records that the file, with the given stat data and content hash, needs no changes. Stat
+ * data from the last couple of seconds is not trusted: the file could still change within
+ * the same mtime tick, so such entries are verified by hash next time.
+ */
+void cache_mark_clean(struct file_cache *fc, const char *path, const struct stat *st, uint64_t hash) {
+    struct cache_entry e;
+    e.path = (char *)cache_key(fc, path);
+    e.hash = hash;
+    e.size = st->st_size;
+    e.mtime_sec = st->st_mtim.tv_sec;
+    e.mtime_nsec = st->st_mtim.tv_nsec;
+    if (e.mtime_sec >= (long long)time(NULL) - 2)
+        e.mtime_sec = e.mtime_nsec = 0;
+    pthread_mutex_lock(&fc->lock);
+    const struct cache_entry *old = cache_slot(fc, e.path);
+    if (!old->path || old->hash != e.hash || old->size != e.size || old->mtime_sec != e.mtime_sec ||
+        old->mtime_nsec != e.mtime_nsec) {
+        if (cache_put(fc, &e))
+            fc->dirty = true;
+    }
+    pthread_mutex_unlock(&fc->lock);
+}
+
+// ----------------- Changed Lines (--since) -----------------
+
+/* struct line_range
+ * Lines [start, end) of a file (0-based) that differ from the --since revision.
+ */
+struct line_range {
+    size_t start, end;
+};
+
+struct changed_file {
+    char *path;  /* as walk_directory() would spell it */
+    struct line_range *ranges;
+    size_t count, capacity;
+};
+
+/* struct change_set
+ * Every .py file that differs from the --since revision, sorted by path, with its changed
+ * line ranges in ascending order.
+ */
+struct change_set {
+    struct changed_file *files;
+    size_t count, capacity;
+};
+
+static bool change_add_range(struct changed_file *cf, size_t start, size_t end) {
+    if (cf->count > 0 && start <= cf->ranges[cf->count - 1].end) {
+        if (end > cf->ranges[cf->count - 1].end)
+            cf->ranges[cf->count - 1].end = end;
+        return true;
+    }
+    if (cf->count >= cf->capacity) {
+        size_t capacity = cf->capacity ? cf->capacity * 2 : 16;
+        struct line_range *tmp = realloc(cf->ranges, capacity * sizeof(*tmp));
+        if (!tmp)
+            return false;
+        cf->ranges = tmp;
+        cf->capacity = capacity;
+    }
+    cf->ranges[cf->count++] = (struct line_range){start, end};
+    return true;
+}
+
+static struct changed_file *change_add_file(struct change_set *cs, const char *root, const char *rel) {
+    if (cs->count >= cs->capacity) {
+        size_t capacity = cs->capacity ? cs->capacity * 2 : 64;
+        struct changed_file *tmp = realloc(cs->files, capacity * sizeof(*tmp));
+        if (!tmp)
+            return NULL;
+        cs->files = tmp;
+        cs->capacity = capacity;
+    }
+    size_t root_len = strlen(root);
+    size_t n = root_len + strlen(rel) + 2;
+    char *path = malloc(n);
+    if (!path)
+        return NULL;
+    bool sep = root_len > 0 && root[root_len - 1] != '/';
+    snprintf(path, n, "%s%s%s", root, sep ? "/" : "", rel);
+    struct changed_file *cf = &cs->files[cs->count++];
+    memset(cf, 0, sizeof(*cf));
+    cf->path = path;
+    return cf;
+}
+
+/* parse_hunk_header()
+ * Reads the new-file side "+c[,d]" of a "@@ -a,b +c,d @@" line into [c-1, c-1+d). A pure
+ * deletion (d == 0) marks the lines on both sides of the gap, since a block around it changed.
+ */
+static bool parse_hunk_header(const char *line, size_t *start, size_t *end) {
+    const char *plus = strstr(line, " +");
+    if (!plus)
+        return false;
+    char *p;
+    unsigned long c = strtoul(plus + 2, &p, 10);
+    unsigned long d = 1;
+    if (*p == ',')
+        d = strtoul(p + 1, &p, 10);
+    if (d == 0) {
+        *start = (c > 0) ? c - 1 : 0;
+        *end = c + 1;
+    } else {
+        *start = c - 1;
+        *end = c - 1 + d;
+    }
+    return true;
+}
+
+static int compare_changed_files(const void *a, const void *b) {
+    return strcmp(((const struct changed_file *)a)->path, ((const struct changed_file *)b)->path);
+}
+
+/* change_set_load()
+ * Runs "git diff --unified=0 --end-of-options <rev> -- <pathspec>" once in 'root' (the target
+ * directory, or "" for the current one) and collects the changed line ranges of every .py file
+ * it lists, working tree changes included. A 'rev' starting with '-' is never taken for an
+ * option. Deleted files are left out. Paths are recorded as root joined with the path relative
+ * to it. Returns false if git could not be run or failed.
+ */
+bool change_set_load(struct change_set *cs, const char *root, const char *pathspec, const char *rev) {
+    memset(cs, 0, sizeof(*cs));
+    int fds[2];
+    if (pipe(fds) == -1) {
+        perror("pipe");
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execlp("git", "git", "-C", root, "-c", "core.quotePath=false", "diff", "--unified=0",
+               "--no-color", "--no-ext-diff", "--no-renames", "--no-prefix", "--relative",
+               "--diff-filter=d", "--end-of-options", rev, "--", pathspec, (char *)NULL);
+        perror("git");
+        _exit(127);
+    }
+    close(fds[1]);
+    FILE *in = fdopen(fds[0], "r");
+    if (!in) {
+        close(fds[0]);
+        waitpid(pid, NULL, 0);
+        return false;
+    }
+    bool ok = true;
+    struct changed_file *cur = NULL;
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    while (ok && (n = getline(&line, &cap, in)) != -1) {
+        strip_crlf(line);
+        if (strncmp(line, "+++ ", 4) == 0) {
+            char *rel = line + 4;
+            // git ends the name with a tab when it contains a space.
+            size_t len = strlen(rel);
+            if (len > 0 && rel[len - 1] == '\t')
+                rel[len - 1] = '\0';
+            const char *ext = strrchr(rel, '.');
+            cur = NULL;
+            // Quoted names (control characters and the like) are not .py files we can match.
+            if (rel[0] != '"' && strcmp(rel, "/dev/null") != 0 && ext && strcmp(ext, ".py") == 0) {
+                cur = change_add_file(cs, root, rel);
+                ok = (cur != NULL);
+            }
+        } else if (cur && strncmp(line, "@@ ", 3) == 0) {
+            size_t start, end;
+            if (parse_hunk_header(line, &start, &end))
+                ok = change_add_range(cur, start, end);
+        }
+    }
+    free(line);
+    fclose(in);
+    int wstatus;
+    if (waitpid(pid, &wstatus, 0) == -1 || !WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+        fprintf(stderr, "Error: 'git diff %s' failed.\n", rev);
+        ok = false;
+    } else if (!ok) {
+        perror("realloc");
+    }
+    if (ok)
+        qsort(cs->files, cs->count, sizeof(*cs->files), compare_changed_files);
+    return ok;
+}
+
+void change_set_free(struct change_set *cs) {
+    for (size_t i = 0; i < cs->count; i++) {
+        free(cs->files[i].path);
+        free(cs->files[i].ranges);
+    }
+    free(cs->files);
+    memset(cs, 0, sizeof(*cs));
+}
+
+/* change_set_find()
+ * Returns the changed ranges recorded for 'path', or NULL if the file is unchanged.
+ */
+const struct changed_file *change_set_find(const struct change_set *cs, const char *path) {
+    struct changed_file key = {.path = (char *)path};
+    return bsearch(&key, cs->files, cs->count, sizeof(*cs->files), compare_changed_files);
+}
+
+/* changed_overlaps()
+ * Returns true if lines [start, end) touch one of cf's ranges. '*cursor' remembers where the
+ * previous lookup ended, so ascending queries cost one pass over the ranges in total.
+ */
+static bool changed_overlaps(const struct changed_file *cf, size_t *cursor, size_t start, size_t end) {
+    while (*cursor < cf->count && cf->ranges[*cursor].end <= start)
+        (*cursor)++;
+    return *cursor < cf->count && cf->ranges[*cursor].start < end;
+}
+
+// ----------------- File/Directory Processing -----------------
+
+enum rule_id { RULE_A, RULE_B, RULE_C, RULE_D };
+
+/* struct edit
+ * Replacement of input lines [start, end) by 'text'. Rule A edits start out with a pending
+ * Black snippet and no text; they get their text once the file's batch has been formatted.
+ * Text and snippet live in the file's arena.
+ */
+struct edit {
+    size_t start, end;
+    enum rule_id rule;
+    char *text;
+    char *snippet;
+    int indent;
+};
+
+struct edit_list {
+    struct edit *items;
+    size_t count, capacity;
+};
+
+/* struct rule_stats
+ * Per-rule totals: lines a rule was tried on, lines it changed, and the time spent in it.
+ */
+struct rule_stats {
+    size_t tried[4], applied[4];
+    uint64_t ns[4];
+};
+
+static void rule_account(struct rule_stats *stats, enum rule_id rule, uint64_t start, bool applied) {
+    stats->tried[rule]++;
+    stats->applied[rule] += applied;
+    stats->ns[rule] += now_ns() - start;
+}
+
+/* struct run_stats
+ * Counters and stage timers behind --stats. Each worker fills its own copy, which is merged
+ * into the run's total at the end; a NULL pointer disables all of it.
+ */
+struct run_stats {
+    size_t files, changed, cached;
+    size_t bytes, lines;
+    uint64_t read_ns, rules_ns, black_ns, write_ns, rename_ns;
+    struct rule_stats rules;
+    size_t black_calls, black_snippets, memo_hits;
+    uint64_t *black_latency; /* one sample per Black call */
+    size_t latency_cap;
+};
+
+/* stats_add_sample()
+ * Appends a Black latency sample. On allocation failure the sample is dropped; the totals
+ * stay exact.
+ */
+static void stats_add_sample(struct run_stats *stats, uint64_t ns) {
+    if (stats->black_calls >= stats->latency_cap) {
+        size_t cap = stats->latency_cap ? stats->latency_cap * 2 : 256;
+        uint64_t *tmp = realloc(stats->black_latency, cap * sizeof(uint64_t));
+        if (!tmp)
+            return;
+        stats->black_latency = tmp;
+        stats->latency_cap = cap;
+    }
+    stats->black_latency[stats->black_calls++] = ns;
+}
+
+/* stats_black_call()
+ * Records one Black call of 'snippets' snippets that took 'ns' nanoseconds.
+ */
+static void stats_black_call(struct run_stats *stats, size_t snippets, uint64_t ns) {
+    stats->black_ns += ns;
+    stats->black_snippets += snippets;
+    stats_add_sample(stats, ns);
+}
+
+/* stats_black_job()
+ * Accounts for a finished job: its memo hits, and a Black call for the rest, if any.
+ */
+static void stats_black_job(struct run_stats *stats, const struct black_job *job) {
+    stats->memo_hits += job->hits;
+    if (job->hits < job->n)
+        stats_black_call(stats, job->n - job->hits, job->ns);
+}
+
+/* stats_merge()
+ * Adds the counters and latency samples of 'src' to 'dst'.
+ */
+static void stats_merge(struct run_stats *dst, const struct run_stats *src) {
+    dst->files += src->files;
+    dst->changed += src->changed;
+    dst->cached += src->cached;
+    dst->bytes += src->bytes;
+    dst->lines += src->lines;
+    dst->read_ns += src->read_ns;
+    dst->rules_ns += src->rules_ns;
+    dst->write_ns += src->write_ns;
+    dst->rename_ns += src->rename_ns;
+    for (int r = RULE_A; r <= RULE_D; r++) {
+        dst->rules.tried[r] += src->rules.tried[r];
+        dst->rules.applied[r] += src->rules.applied[r];
+        dst->rules.ns[r] += src->rules.ns[r];
+    }
+    dst->black_snippets += src->black_snippets;
+    dst->memo_hits += src->memo_hits;
+    dst->black_ns += src->black_ns;
+    for (size_t i = 0; i < src->black_calls; i++)
+        stats_add_sample(dst, src->black_latency[i]);
+}
+
+static void stats_free(struct run_stats *stats) {
+    free(stats->black_latency);
+    memset(stats, 0, sizeof(*stats));
+}
+
+#ifndef REFLOW_NO_MAIN
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* stats_percentile()
+ * Nearest-rank percentile of the sorted samples, or 0 without samples.
+ */
+static uint64_t stats_percentile(const uint64_t *sorted, size_t n, int pct) {
+    if (n == 0)
+        return 0;
+    size_t rank = (n * pct + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+/* stats_report()
+ * Prints the totals to 'out', as a readable summary or as one JSON object.
+ */
+static void stats_report(FILE *out, struct run_stats *stats, uint64_t wall_ns, bool json) {
+    qsort(stats->black_latency, stats->black_calls, sizeof(uint64_t), compare_u64);
+    const uint64_t *lat = stats->black_latency;
+    size_t n = stats->black_calls;
+    uint64_t p50 = stats_percentile(lat, n, 50), p90 = stats_percentile(lat, n, 90);
+    uint64_t p99 = stats_percentile(lat, n, 99), max = n ? lat[n - 1] : 0;
+    if (json) {
+        fprintf(out, "{\"files\":%zu,\"changed\":%zu,\"cached\":%zu,\"bytes\":%zu,\"lines\":%zu,"
+                     "\"wall_ns\":%llu,\"stages_ns\":{\"read\":%llu,\"rules\":%llu,\"black\":%llu,"
+                     "\"write\":%llu,\"rename\":%llu},\"rules\":{",
+                stats->files, stats->changed, stats->cached, stats->bytes, stats->lines,
+                (unsigned long long)wall_ns, (unsigned long long)stats->read_ns,
+                (unsigned long long)stats->rules_ns, (unsigned long long)stats->black_ns,
+                (unsigned long long)stats->write_ns, (unsigned long long)stats->rename_ns);
+        for (int r = RULE_A; r <= RULE_D; r++)
+            fprintf(out, "%s\"%c\":{\"tried\":%zu,\"applied\":%zu,\"ns\":%llu}", r ? "," : "", 'A' + r,
+                    stats->rules.tried[r], stats->rules.applied[r], (unsigned long long)stats->rules.ns[r]);
+        fprintf(out, "},\"black\":{\"calls\":%zu,\"snippets\":%zu,\"memo_hits\":%zu,\"latency_ns\":{"
+                     "\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"max\":%llu}}}\n",
+                n, stats->black_snippets, stats->memo_hits, (unsigned long long)p50, (unsigned long long)p90,
+                (unsigned long long)p99, (unsigned long long)max);
+        return;
+    }
+    fprintf(out, "Stats: %zu file(s) (%zu changed, %zu skipped by the cache), %.2f MB, %zu lines, %.3f s\n",
+            stats->files, stats->changed, stats->cached, stats->bytes / 1e6, stats->lines, wall_ns / 1e9);
+    fprintf(out, "  %-8s %12s\n", "stage", "time (ms)");
+    fprintf(out, "  %-8s %12.3f\n", "read", stats->read_ns / 1e6);
+    fprintf(out, "  %-8s %12.3f\n", "rules", stats->rules_ns / 1e6);
+    fprintf(out, "  %-8s %12.3f\n", "black", stats->black_ns / 1e6);
+    fprintf(out, "  %-8s %12.3f\n", "write", stats->write_ns / 1e6);
+    fprintf(out, "  %-8s %12.3f\n", "rename", stats->rename_ns / 1e6);
+    fprintf(out, "  %-5s %10s %10s %12s\n", "rule", "tried", "applied", "time (ms)");
+    for (int r = RULE_A; r <= RULE_D; r++)
+        fprintf(out, "  %-5c %10zu %10zu %12.3f\n", 'A' + r, stats->rules.tried[r],
+                stats->rules.applied[r], stats->rules.ns[r] / 1e6);
+    fprintf(out, "  black: %zu call(s), %zu snippet(s), %zu memo hit(s); latency p50 %.3f ms, p90 %.3f ms, "
+                 "p99 %.3f ms, max %.3f ms\n",
+            n, stats->black_snippets, stats->memo_hits, p50 / 1e6, p90 / 1e6, p99 / 1e6, max / 1e6);
+}
+#endif
+
+/* add_edit()
+ * Appends an edit. Returns false on allocation failure.
+ */
+static bool add_edit(struct edit_list *edits, const struct edit *e) {
+    if (edits->count >= edits->capacity) {
+        size_t capacity = (edits->capacity == 0) ? 64 : edits->capacity * 2;
+        struct edit *tmp = realloc(edits->items, capacity * sizeof(struct edit));
+        if (!tmp)
+            return false;
+        edits->items = tmp;
+        edits->capacity = capacity;
+    }
+    edits->items[edits->count++] = *e;
+    return true;
+}
+
+/* apply_rules_with()
+ * Runs the rule chain on line i of src: Rule D, then A, B and C, leaving out the rules that
+ * 'rules' does not include. If one of them applies, fills *e with the replaced line range and
+ * its result (allocated from 'arena') and returns true. Rule A results only carry the
+ * extracted snippet; the caller has it formatted by Black. If 'stats' is not NULL, every rule
+ * that runs is timed and counted there. Always inlined into the apply_rules_*() variants,
+ * where 'rules' is a constant, so the tests for disabled rules are compiled away.
+ */
+static inline __attribute__((always_inline))
+bool apply_rules_with(const struct source *src, size_t i, struct edit *e, struct arena *arena,
+                      struct rule_stats *stats, unsigned rules) {
+    const char *line = src->data + src->lines[i].off;
+    size_t len = src->lines[i].len;
+    unsigned flags = src->lines[i].flags;
+    memset(e, 0, sizeof(*e));
+    e->start = i;
+    e->end = i + 1;
+    bool long_comment = (flags & (LINE_HASH | LINE_LONG)) == (LINE_HASH | LINE_LONG);
+    bool inline_rules = rules & RULE_BIT(RULE_B);
+    bool comment_rules = rules & (RULE_BIT(RULE_A) | RULE_BIT(RULE_C));
+    if (!((rules & RULE_BIT(RULE_D)) && (flags & LINE_TQ_OPEN)) &&
+        !(long_comment && (inline_rules || comment_rules)))
+        return false;
+    uint64_t t = 0;
+    // Rule D: Process existing triple-quoted blocks.
+    if ((rules & RULE_BIT(RULE_D)) && (flags & LINE_TQ_OPEN)) {
+        e->rule = RULE_D;
+        if (stats)
+            t = now_ns();
+        e->text = process_triple_quote_block(src, i, &e->end, arena);
+        if (stats)
+            rule_account(stats, RULE_D, t, e->text != NULL);
+        if (e->text)
+            return true;
+        e->end = i + 1;
+    }
+    if (!long_comment)
+        return false;
+    if (!(flags & LINE_COMMENT)) {
+        if (!inline_rules)
+            return false;
+        // Rule B: Split inline comments.
+        e->rule = RULE_B;
+        if (stats)
+            t = now_ns();
+        e->text = split_inline_comment(src, i, arena);
+        if (stats)
+            rule_account(stats, RULE_B, t, e->text != NULL);
+        return e->text != NULL;
+    }
+    // Rule A: Process commented-out print statements.
+    if (rules & RULE_BIT(RULE_A)) {
+        e->rule = RULE_A;
+        if (stats)
+            t = now_ns();
+        e->snippet = extract_commented_print(line, len, src->width, &e->indent, arena);
+        if (stats)
+            rule_account(stats, RULE_A, t, e->snippet != NULL);
+        if (e->snippet)
+            return true;
+    }
+    // Rule C: Merge consecutive full-line comments.
+    if ((rules & RULE_BIT(RULE_C)) && len > (size_t)src->width) {
+        e->rule = RULE_C;
+        if (stats)
+            t = now_ns();
+        e->text = merge_comment_block(src, i, &e->end, arena);
+        if (stats)
+            rule_account(stats, RULE_C, t, e->text != NULL);
+        if (e->text)
+            return true;
+    }
+    return false;
+}
+
+/* One apply_rules_<mask>() per rule set, each with its own copy of the chain. */
+#define RULE_CHAIN(mask)                                                                      \
+    static bool apply_rules_##mask(const struct source *src, size_t i, struct edit *e,        \
+                                   struct arena *arena, struct rule_stats *stats) {           \
+        return apply_rules_with(src, i, e, arena, stats, mask);                               \
+    }
+RULE_CHAIN(0)  RULE_CHAIN(1)  RULE_CHAIN(2)  RULE_CHAIN(3)
+RULE_CHAIN(4)  RULE_CHAIN(5)  RULE_CHAIN(6)  RULE_CHAIN(7)
+RULE_CHAIN(8)  RULE_CHAIN(9)  RULE_CHAIN(10) RULE_CHAIN(11)
+RULE_CHAIN(12) RULE_CHAIN(13) RULE_CHAIN(14) RULE_CHAIN(15)
+#undef RULE_CHAIN
+
+/* rule_set_init()
+ * Sets up the rules in 'mask' (RULE_BIT()s) for lines of at most 'width' bytes, wrapping as
+ * 'wrap' says, and picks the variant of the rule chain compiled for that mask, so no line ever
+ * tests for a disabled rule.
+ */
+static void rule_set_init(struct rule_set *rs, unsigned mask, int width, enum wrap_mode wrap) {
+    static bool (*const chains[16])(const struct source *, size_t, struct edit *, struct arena *,
+                                    struct rule_stats *) = {
+        apply_rules_0,  apply_rules_1,  apply_rules_2,  apply_rules_3,
+        apply_rules_4,  apply_rules_5,  apply_rules_6,  apply_rules_7,
+        apply_rules_8,  apply_rules_9,  apply_rules_10, apply_rules_11,
+        apply_rules_12, apply_rules_13, apply_rules_14, apply_rules_15,
+    };
+    rs->mask = mask & RULES_ALL;
+    rs->width = width;
+    rs->wrap = wrap;
+    rs->apply = chains[rs->mask];
+}
+
+static void free_edits(struct edit_list *edits) {
+    free(edits->items);
+}
+
+/* Rule A snippets per Black job: enough to keep round trips few, few enough that the snippets
+ * of one file spread over several workers. */
+#define PRINT_CHUNK 16
+
+/* struct print_chunk
+ * Up to PRINT_CHUNK Rule A snippets of a file, submitted to Black as one job, and the indices
+ * of the edits they belong to.
+ */
+struct print_chunk {
+    struct black_job job;
+    char *snippets[PRINT_CHUNK];
+    char *results[PRINT_CHUNK];
+    size_t edits[PRINT_CHUNK];
+    struct print_chunk *next;
+};
+
+/* struct print_queue
+ * The Rule A snippets of a file on their way through Black, in line order: every chunk but
+ * 'open' has been submitted.
+ */
+struct print_queue {
+    struct print_chunk *first, *last;
+    struct print_chunk *open;
+};
+
+/* queue_print()
+ * Adds the snippet of edit 'index' to the queue and submits the current chunk once it is
+ * full. Chunks are allocated from 'arena'. Returns false on allocation failure.
+ */
+static bool queue_print(struct print_queue *q, struct black_backend *bb, struct edit_list *edits,
+                        size_t index, struct arena *arena) {
+    struct print_chunk *c = q->open;
+    if (!c) {
+        c = arena_alloc(arena, sizeof(*c));
+        if (!c)
+            return false;
+        memset(c, 0, sizeof(*c));
+        c->job.snippets = c->snippets;
+        c->job.results = c->results;
+        if (q->last)
+            q->last->next = c;
+        else
+            q->first = c;
+        q->last = q->open = c;
+    }
+    c->snippets[c->job.n] = edits->items[index].snippet;
+    c->edits[c->job.n++] = index;
+    if (c->job.n == PRINT_CHUNK) {
+        black_submit(bb, &c->job);
+        q->open = NULL;
+    }
+    return true;
+}
+
+/* print_fallback()
+ * Black could not format the Rule A snippet of edit 'e'. The line is then treated as the rule
+ * chain without Rule A would treat it: if it is long enough and the rule set has Rule C, the
+ * comment run that starts there is merged. Returns true if that happened, with 'e' now the
+ * Rule C edit; otherwise 'e' keeps a NULL text and the line stays as it is.
+ */
+static bool print_fallback(const struct source *src, const struct rule_set *rules, struct edit *e,
+                           struct arena *arena, struct rule_stats *stats) {
+    if (!(rules->mask & RULE_BIT(RULE_C)) || src->lines[e->start].len <= (size_t)src->width)
+        return false;
+    uint64_t t = stats ? now_ns() : 0;
+    size_t end = e->end;
+    char *text = merge_comment_block(src, e->start, &end, arena);
+    if (stats)
+        rule_account(stats, RULE_C, t, text != NULL);
+    if (!text)
+        return false;
+    e->rule = RULE_C;
+    e->text = text;
+    e->end = end;
+    return true;
+}
+
+/* drop_covered_edits()
+ * Removes the edits that start inside an earlier edit's range, which a Rule C fallback leaves
+ * behind: the scan went on past the print line and found edits in the run it now merges.
+ */
+static void drop_covered_edits(struct edit_list *edits) {
+    size_t kept = 0, end = 0;
+    for (size_t i = 0; i < edits->count; i++) {
+        if (kept > 0 && edits->items[i].start < end)
+            continue;
+        edits->items[kept++] = edits->items[i];
+        end = edits->items[i].end;
+    }
+    edits->count = kept;
+}
+
+/* finish_prints()
+ * Submits what is left in the queue, waits for every chunk, and turns the results into
+ * triple-quoted blocks. A snippet that could not be formatted falls back to Rule C with
+ * print_fallback(), or else keeps a NULL text and leaves its line unchanged. Every job is
+ * accounted in 'stats' unless it is NULL.
+ */
+static void finish_prints(struct print_queue *q, const struct source *src,
+                          const struct rule_set *rules, struct edit_list *edits,
+                          struct black_backend *bb, struct arena *arena, struct run_stats *stats) {
+    if (q->open)
+        black_submit(bb, &q->open->job);
+    bool merged = false;
+    for (struct print_chunk *c = q->first; c; c = c->next) {
+        black_wait(bb, &c->job);
+        if (stats)
+            stats_black_job(stats, &c->job);
+        for (size_t k = 0; k < c->job.n; k++) {
+            struct edit *e = &edits->items[c->edits[k]];
+            char *formatted = c->results[k];
+            e->snippet = NULL;
+            if (!formatted) {
+                fprintf(stderr, "Error: Failed to run black. Ensure it is in your PATH.\n");
+                merged |= print_fallback(src, rules, e, arena, stats ? &stats->rules : NULL);
+                continue;
+            }
+            e->text = build_print_block(formatted, e->indent, arena);
+        }
+    }
+    if (merged)
+        drop_covered_edits(edits);
+    memset(q, 0, sizeof(*q));
+}
+
+/* find_edits()
+ * Runs the rule set over src and collects the blocks it rewrites in 'edits', in line order.
+ * With 'changed', only blocks that overlap those lines are kept. Rule A snippets are formatted
+ * by 'bb' while the other rules carry on; without a backend they keep a NULL text. Rule output
+ * is allocated from 'arena'. Unless 'stats' is NULL, the rules are timed and counted there.
+ * Returns false on allocation failure.
+ */
+static bool find_edits_in(const struct source *src, size_t lo, size_t hi,
+                          const struct rule_set *rules, struct black_backend *bb,
+                          const struct changed_file *changed, struct edit_list *edits,
+                          struct arena *arena, struct run_stats *stats) {
+    uint64_t t = stats ? now_ns() : 0;
+    bool ok = true;
+    // The pre-scan already knows whether any line can be changed at all.
+    size_t cursor = 0;
+    struct print_queue prints = {0};
+    for (size_t i = lo; i < hi && ok && src->candidates > 0; i++) {
+        struct edit e;
+        if (rules->apply(src, i, &e, arena, stats ? &stats->rules : NULL)) {
+            // Blocks outside the changed lines are left alone as a whole.
+            if (changed && !changed_overlaps(changed, &cursor, e.start, e.end)) {
+                i = e.end - 1;
+                continue;
+            }
+            // Rule A snippets go to Black in chunks while the other rules carry on.
+            ok = add_edit(edits, &e) &&
+                 (!e.snippet || !bb || queue_print(&prints, bb, edits, edits->count - 1, arena));
+            i = e.end - 1;
+        }
+    }
+    if (stats)
+        stats->rules_ns += now_ns() - t;
+    // Jobs already submitted point into the arena, so they are collected even on failure.
+    if (bb)
+        finish_prints(&prints, src, rules, edits, bb, arena, stats);
+    return ok;
+}
+
+static bool find_edits(const struct source *src, const struct rule_set *rules,
+                       struct black_backend *bb, const struct changed_file *changed,
+                       struct edit_list *edits, struct arena *arena, struct run_stats *stats) {
+    return find_edits_in(src, 0, src->count, rules, bb, changed, edits, arena, stats);
+}
+
+/* Files at least this large have their rules split over --file-jobs threads. */
+#define FILE_SPLIT_MIN (4u << 20)
+
+/* split_point()
+ * Returns the first line from 'line' on that no rule can reach across: one that does not start
+ * inside a string literal (so no Rule D block is open) and does not continue a run of full-line
+ * comments (which Rule C would merge). Rules A and B only ever look at one line. Running the
+ * rules on the lines before and after such a line separately finds the same edits as one pass.
+ */
+static size_t split_point(const struct source *src, size_t line) {
+    for (; line < src->count; line++) {
+        unsigned flags = src->lines[line].flags;
+        if (!(flags & LINE_IN_STRING) &&
+            !((flags & LINE_COMMENT) && (src->lines[line - 1].flags & LINE_COMMENT)))
+            break;
+    }
+    return line;
+}
+
+/* struct file_chunk
+ * A range of lines of a split file, and the edits one thread found in it.
+ */
+struct file_chunk {
+    const struct source *src;
+    size_t lo, hi;
+    const struct rule_set *rules;
+    struct black_backend *bb;
+    const struct changed_file *changed;
+    struct edit_list edits;
+    struct arena arena;
+    struct run_stats stats;
+    bool want_stats, ok;
+    pthread_t thread;
+};
+
+static void *chunk_main(void *arg) {
+    struct file_chunk *c = arg;
+    c->ok = find_edits_in(c->src, c->lo, c->hi, c->rules, c->bb, c->changed, &c->edits,
+                          &c->arena, c->want_stats ? &c->stats : NULL);
+    return NULL;
+}
+
+/* find_edits_split()
+ * Like find_edits(), but splits src at split_point()s into about 'njobs' ranges of lines and runs
+ * the rules on them in parallel, the calling thread taking the first one. Rule A snippets of
+ * every range go to the shared Black backend. The edits are joined in line order, with their
+ * text copied to 'arena', so the result is the same as that of find_edits().
+ */
+static bool find_edits_split(const struct source *src, const struct rule_set *rules,
+                             struct black_backend *bb, const struct changed_file *changed,
+                             struct edit_list *edits, struct arena *arena, struct run_stats *stats,
+                             int njobs) {
+    struct file_chunk *chunks = calloc(njobs, sizeof(*chunks));
+    if (!chunks)
+        return false;
+    int n = 0;
+    for (size_t lo = 0; lo < src->count && n < njobs; n++) {
+        size_t target = src->count / njobs * (n + 1);
+        size_t hi = (n + 1 == njobs) ? src->count : split_point(src, target > lo ? target : lo + 1);
+        chunks[n] = (struct file_chunk){src, lo, hi, rules, bb, changed, .want_stats = stats != NULL};
+        lo = hi;
+    }
+    int started = 0;
+    for (int k = 1; k < n; k++, started++)
+        if (pthread_create(&chunks[k].thread, NULL, chunk_main, &chunks[k]) != 0)
+            break;
+    if (n > 0)
+        chunk_main(&chunks[0]);
+    // Ranges no thread could be started for are done here.
+    for (int k = started + 1; k < n; k++)
+        chunk_main(&chunks[k]);
+    for (int k = 1; k <= started; k++)
+        pthread_join(chunks[k].thread, NULL);
+    bool ok = true;
+    uint64_t rules_ns = 0;
+    for (int k = 0; k < n; k++) {
+        struct file_chunk *c = &chunks[k];
+        ok = ok && c->ok;
+        // The ranges ran side by side: the rules took as long as the slowest one.
+        if (c->stats.rules_ns > rules_ns)
+            rules_ns = c->stats.rules_ns;
+        c->stats.rules_ns = 0;
+        for (size_t i = 0; ok && i < c->edits.count; i++) {
+            struct edit e = c->edits.items[i];
+            if (e.text) {
+                size_t len = strlen(e.text) + 1;
+                char *copy = arena_alloc(arena, len);
+                if (copy)
+                    memcpy(copy, e.text, len);
+                e.text = copy;
+                ok = copy != NULL;
+            }
+            ok = ok && add_edit(edits, &e);
+        }
+        if (stats)
+            stats_merge(stats, &c->stats);
+        stats_free(&c->stats);
+        free_edits(&c->edits);
+        arena_free(&c->arena);
+    }
+    if (stats)
+        stats->rules_ns += rules_ns;
+    free(chunks);
+    return ok;
+}
+
+/* report_edit()
+ * Writes the per-rule progress message for an applied edit to 'log'.
+ */
+static void report_edit(FILE *log, const char *filename, const struct edit *e) {
+    switch (e->rule) {
+    case RULE_D:
+        fprintf(log, "Processed triple-quoted block in %s (lines %zu-%zu).\n", filename, e->start+1, e->end);
+        break;
+    case RULE_A:
+        fprintf(log, "Modified commented-out print in %s at line %zu.\n", filename, e->start+1);
+        break;
+    case RULE_B:
+        fprintf(log, "Split inline comment in %s at line %zu.\n", filename, e->start+1);
+        break;
+    case RULE_C:
+        fprintf(log, "Merged comment block in %s from line %zu to %zu.\n", filename, e->start+1, e->end);
+        break;
+    }
+}
+
+// Unchanged stretches at least this long are copied file to file instead of through memory.
+#define COPY_RANGE_MIN (16 * 1024)
+// Ranges per writev() call (IOV_MAX is 1024 on Linux and the BSDs).
+#define EMIT_IOVECS 256
+
+/* struct iov_batch
+ * Output ranges waiting for one writev(): unchanged stretches point into the source buffer
+ * (usually its mapping) and replacements into the arena, so no byte is copied to get there.
+ */
+struct iov_batch {
+    struct iovec iov[EMIT_IOVECS];
+    int count;
+};
+
+/* iov_flush()
+ * Writes every range of the batch to fd, picking up after short writes, and empties it.
+ * Returns false on a write error.
+ */
+static bool iov_flush(int fd, struct iov_batch *b) {
+    struct iovec *iov = b->iov;
+    int n = b->count;
+    b->count = 0;
+    while (n > 0) {
+        ssize_t w = writev(fd, iov, n);
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        size_t left = (size_t)w;
+        while (n > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+    return true;
+}
+
+/* iov_add()
+ * Queues the n bytes at p for writing to fd, flushing the batch first if it is full.
+ * The bytes must stay put until the batch is flushed. Returns false on a write error.
+ */
+static bool iov_add(int fd, struct iov_batch *b, const char *p, size_t n) {
+    if (n == 0)
+        return true;
+    if (b->count == EMIT_IOVECS && !iov_flush(fd, b))
+        return false;
+    b->iov[b->count++] = (struct iovec){(void *)p, n};
+    return true;
+}
+
+/* copy_source_range()
+ * Copies bytes [start, end) of the source file to fd inside the kernel, which lets filesystems
+ * with reflinks share the extents instead of writing them. Returns the number of bytes copied,
+ * stopping early (possibly at 0) where copy_file_range() is not supported for this pair of files.
+ */
+static size_t copy_source_range(int fd, const struct source *src, size_t start, size_t end) {
+    size_t done = 0;
+#ifdef __linux__
+    loff_t off = (loff_t)start;
+    while (src->fd >= 0 && start + done < end) {
+        ssize_t n = copy_file_range(src->fd, &off, fd, NULL, end - start - done, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        done += (size_t)n;
+    }
+#else
+    (void)fd; (void)src; (void)start; (void)end;
+#endif
+    return done;
+}
+
+/* emit_edits()
+ * Writes src to fd with every edit that has a text applied, reporting each one to 'log' unless
+ * it is NULL. Replacement texts and unchanged stretches are written in place with writev(),
+ * EMIT_IOVECS ranges at a time; long unchanged stretches (typically the prefix before the first
+ * edit and the suffix after the last) are copied with copy_source_range() when possible.
+ * Returns false on a write error.
+ */
+static bool emit_edits(int fd, const struct source *src, const struct edit_list *edits,
+                       const char *filename, FILE *log) {
+    struct iov_batch batch;
+    batch.count = 0;
+    size_t copy_from = 0;  // Start of the unchanged bytes not emitted yet.
+    bool ok = true;
+    for (size_t i = 0; ok && i <= edits->count; i++) {
+        const struct edit *e = (i < edits->count) ? &edits->items[i] : NULL;
+        if (e && !e->text)
+            continue;
+        size_t until = e ? src->lines[e->start].off : src->size;
+        if (until - copy_from >= COPY_RANGE_MIN) {
+            ok = iov_flush(fd, &batch);
+            if (ok)
+                copy_from += copy_source_range(fd, src, copy_from, until);
+        }
+        ok = ok && iov_add(fd, &batch, src->data + copy_from, until - copy_from);
+        if (ok && e) {
+            if (log)
+                report_edit(log, filename, e);
+            ok = iov_add(fd, &batch, e->text, strlen(e->text));
+            copy_from = src->lines[e->end - 1].off + src->lines[e->end - 1].len;
+        }
+    }
+    return ok && iov_flush(fd, &batch);
+}
+
+/* replace_file()
+ * Writes the result for src to a temporary file in the same directory as 'filename', gives it
+ * the original's permissions and (where allowed) owner, and renames it over the original.
+ * Staying in one directory keeps the rename atomic and avoids EXDEV when /tmp is another
+ * filesystem. Returns 0 on success and -1 on failure, leaving the original untouched.
+ */
+static int replace_file(const char *filename, const struct source *src, const struct edit_list *edits,
+                        const struct stat *st, struct run_stats *stats, FILE *log) {
+    uint64_t t = stats ? now_ns() : 0;
+    char tmp_out[BUFFER_SIZE];
+    const char *slash = strrchr(filename, '/');
+    if (slash)
+        snprintf(tmp_out, sizeof(tmp_out), "%.*s/.%s.reflowXXXXXX", (int)(slash - filename), filename, slash + 1);
+    else
+        snprintf(tmp_out, sizeof(tmp_out), ".%s.reflowXXXXXX", filename);
+    int fd_out = mkstemp(tmp_out);
+    if (fd_out == -1) {
+        perror("mkstemp output");
+        return -1;
+    }
+    if (fchmod(fd_out, st->st_mode & 07777) != 0) {
+        perror(tmp_out);
+        goto fail;
+    }
+    // Only root can give a file away; members of the file's group can still keep the group.
+    if ((st->st_uid != geteuid() || st->st_gid != getegid()) &&
+        fchown(fd_out, st->st_uid, st->st_gid) != 0 &&
+        fchown(fd_out, (uid_t)-1, st->st_gid) != 0 && errno != EPERM) {
+        perror(tmp_out);
+        goto fail;
+    }
+    if (!emit_edits(fd_out, src, edits, filename, log)) {
+        perror(tmp_out);
+        goto fail;
+    }
+    if (close(fd_out) != 0) {
+        fd_out = -1;
+        perror(tmp_out);
+        goto fail;
+    }
+    if (stats) {
+        uint64_t now = now_ns();
+        stats->write_ns += now - t;
+        t = now;
+    }
+    if (rename(tmp_out, filename) != 0) {
+        perror("rename");
+        remove(tmp_out);
+        return -1;
+    }
+    if (stats)
+        stats->rename_ns += now_ns() - t;
+    return 0;
+fail:
+    if (fd_out != -1)
+        close(fd_out);
+    remove(tmp_out);
+    return -1;
+}
+
+/* edit_changes_text()
+ * Returns true if the edit has a text and it differs from the lines it replaces.
+ */
+static bool edit_changes_text(const struct source *src, const struct edit *e) {
+    if (!e->text)
+        return false;
+    size_t off = src->lines[e->start].off;
+    size_t end = src->lines[e->end - 1].off + src->lines[e->end - 1].len;
+    size_t n = strlen(e->text);
+    return n != end - off || memcmp(src->data + off, e->text, n) != 0;
+}
+
+/* render_edits()
+ * Writes src with every edit that has a text applied to 'out', which must have room for the
+ * result; with 'out' NULL, only measures it. Returns the length of the result.
+ */
+static size_t render_edits(const struct source *src, const struct edit_list *edits, char *out) {
+    size_t len = 0;
+    size_t copy_from = 0;  // Start of the unchanged bytes not written yet.
+    for (size_t i = 0; i <= edits->count; i++) {
+        const struct edit *e = (i < edits->count) ? &edits->items[i] : NULL;
+        if (e && !e->text)
+            continue;
+        size_t until = e ? src->lines[e->start].off : src->size;
+        if (out)
+            memcpy(out + len, src->data + copy_from, until - copy_from);
+        len += until - copy_from;
+        if (!e)
+            break;
+        size_t n = strlen(e->text);
+        if (out)
+            memcpy(out + len, e->text, n);
+        len += n;
+        copy_from = src->lines[e->end - 1].off + src->lines[e->end - 1].len;
+    }
+    return len;
+}
+
+#define DIFF_CONTEXT 3
+
+/* diff_line()
+ * Writes one diff line with its prefix, marking a last line that has no newline.
+ */
+static void diff_line(FILE *out, char prefix, const char *line, size_t len) {
+    fputc(prefix, out);
+    fwrite(line, 1, len, out);
+    if (len == 0 || line[len - 1] != '\n')
+        fputs("\n\\ No newline at end of file\n", out);
+}
+
+static size_t count_newlines(const char *s) {
+    size_t n = 0;
+    while ((s = strchr(s, '\n')) != NULL) {
+        n++;
+        s++;
+    }
+    return n;
+}
+
+/* write_unified_diff()
+ * Writes the changing edits of src as a unified diff with DIFF_CONTEXT lines of context.
+ * Edits closer than twice the context share a hunk.
+ */
+static void write_unified_diff(FILE *out, const char *filename, const struct source *src,
+                               const struct edit_list *edits) {
+    fprintf(out, "--- %s\n+++ %s\n", filename, filename);
+    long delta = 0;  // New line numbers minus old ones before the current hunk.
+    size_t k = 0;
+    while (k < edits->count) {
+        if (!edit_changes_text(src, &edits->items[k])) {
+            k++;
+            continue;
+        }
+        // Extend the hunk over every changing edit within reach of its context.
+        size_t first = k, last = k;
+        for (size_t j = k + 1; j < edits->count; j++) {
+            const struct edit *e = &edits->items[j];
+            if (e->start - edits->items[last].end > 2 * DIFF_CONTEXT)
+                break;
+            if (edit_changes_text(src, e))
+                last = j;
+        }
+        size_t old_start = edits->items[first].start;
+        old_start = (old_start > DIFF_CONTEXT) ? old_start - DIFF_CONTEXT : 0;
+        size_t old_end = edits->items[last].end + DIFF_CONTEXT;
+        if (old_end > src->count)
+            old_end = src->count;
+        long added = 0;
+        for (size_t j = first; j <= last; j++) {
+            const struct edit *e = &edits->items[j];
+            if (edit_changes_text(src, e))
+                added += (long)count_newlines(e->text) - (long)(e->end - e->start);
+        }
+        size_t old_len = old_end - old_start;
+        size_t new_len = (size_t)((long)old_len + added);
+        fprintf(out, "@@ -%zu,%zu +%ld,%zu @@\n", old_start + 1, old_len,
+                (long)old_start + 1 + delta, new_len);
+        size_t j = first;
+        for (size_t i = old_start; i < old_end; i++) {
+            while (j <= last && edits->items[j].end <= i)
+                j++;
+            const struct edit *e = (j <= last) ? &edits->items[j] : NULL;
+            if (e && e->start == i && edit_changes_text(src, e)) {
+                for (size_t l = e->start; l < e->end; l++)
+                    diff_line(out, '-', src->data + src->lines[l].off, src->lines[l].len);
+                const char *t = e->text;
+                while (*t) {
+                    const char *nl = strchr(t, '\n');
+                    size_t n = nl ? (size_t)(nl - t) + 1 : strlen(t);
+                    diff_line(out, '+', t, n);
+                    t += n;
+                }
+                i = e->end - 1;
+                continue;
+            }
+            diff_line(out, ' ', src->data + src->lines[i].off, src->lines[i].len);
+        }
+        delta += added;
+        k = last + 1;
+    }
+}
+
+/* struct shard
+ * This node's part of a run split with --shard: shard 'index' (from 0) of 'count'. Files are
+ * told apart by their path below the target ('root_len' bytes of the path are skipped). By
+ * default a file belongs to the shard its path hashes to; with --shard-by=size, shard_plan()
+ * has listed the files of this shard in 'paths', sorted, for a balanced share of the bytes.
+ */
+struct shard {
+    unsigned index, count;
+    bool by_size;
+    size_t root_len;
+    char **paths;
+    size_t npaths;
+};
+
+/* relative_path()
+ * The part of 'path' below the target directory whose name is 'root_len' bytes long.
+ */
+static const char *relative_path(const char *path, size_t root_len) {
+    const char *rel = path + (strlen(path) >= root_len ? root_len : 0);
+    while (*rel == '/')
+        rel++;
+    return rel;
+}
+
+static int compare_strings(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* shard_owns()
+ * Returns true if 'path' belongs to this node's shard. The answer depends only on the path
+ * below the target, so every node agrees whatever its checkout is called.
+ */
+static bool shard_owns(const struct shard *shard, const char *path) {
+    const char *rel = relative_path(path, shard->root_len);
+    if (!shard->by_size)
+        return xxh64(rel, strlen(rel), 0) % shard->count == shard->index;
+    return bsearch(&rel, shard->paths, shard->npaths, sizeof(char *), compare_strings) != NULL;
+}
+
+/* struct manifest
+ * The JSON Lines file --emit-manifest writes for this node (see manifest_open()). Workers
+ * append one record per file that changed, would change or failed, under 'lock'.
+ */
+struct manifest {
+    FILE *out;
+    pthread_mutex_t lock;
+    size_t root_len; /* as in struct shard */
+};
+
+/* json_write_string()
+ * Writes the n bytes at s as a JSON string literal. Bytes from 0x80 up are copied as they are.
+ */
+static void json_write_string(FILE *out, const char *s, size_t n) {
+    putc('"', out);
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\')
+            fprintf(out, "\\%c", c);
+        else if (c == '\n')
+            fputs("\\n", out);
+        else if (c < 0x20)
+            fprintf(out, "\\u%04x", c);
+        else
+            putc(c, out);
+    }
+    putc('"', out);
+}
+
+/* manifest_add()
+ * Records the outcome of one file in the manifest, if there is one: 'result' is one of
+ * "changed", "would-change", "not-idempotent" and "failed", and 'diff' (NULL if there is none)
+ * the file's --diff output of 'diff_len' bytes.
+ */
+static void manifest_add(struct manifest *m, const char *path, const char *result, int changes,
+                         const char *diff, size_t diff_len) {
+    if (!m)
+        return;
+    const char *rel = relative_path(path, m->root_len);
+    pthread_mutex_lock(&m->lock);
+    fputs("{\"path\":", m->out);
+    json_write_string(m->out, rel, strlen(rel));
+    fprintf(m->out, ",\"result\":\"%s\",\"changes\":%d", result, changes);
+    if (diff) {
+        fputs(",\"diff\":", m->out);
+        json_write_string(m->out, diff, diff_len);
+    }
+    fputs("}\n", m->out);
+    pthread_mutex_unlock(&m->lock);
+}
+
+/* verify_fixed_point()
+ * Second pass of --verify-idempotent: renders the edits the first pass found for src in memory
+ * and runs the rules on the result. A file whose result the rules would change again is counted
+ * and reported to 'log' with the blocks that change. Returns 0, or -1 if memory ran out.
+ */
+static int verify_fixed_point(const char *filename, const struct source *src,
+                              const struct edit_list *edits, struct run_context *ctx,
+                              struct arena *arena, FILE *log) {
+    bool needed = false;
+    for (size_t i = 0; i < edits->count && !needed; i++)
+        needed = edit_changes_text(src, &edits->items[i]);
+    // Nothing changed, so the second pass would see the same input.
+    if (!needed)
+        return 0;
+    atomic_fetch_add(&ctx->verified, 1);
+    uint64_t t = now_ns();
+    size_t n = render_edits(src, edits, NULL);
+    char *text = malloc(n + 1);
+    if (!text) {
+        perror("malloc");
+        return -1;
+    }
+    render_edits(src, edits, text);
+    text[n] = '\0';
+    struct source again = {.data = text, .size = n, .width = src->width, .wrap = src->wrap,
+                           .fd = -1};
+    struct edit_list second = {0};
+    int status = -1;
+    if (scan_source(&again) != 0 ||
+        !find_edits(&again, &ctx->rules, ctx->bb, NULL, &second, arena, NULL)) {
+        perror("malloc");
+        goto done;
+    }
+    atomic_fetch_add(&ctx->pass_ns[1], now_ns() - t);
+    int changes = 0;
+    for (size_t i = 0; i < second.count; i++) {
+        const struct edit *e = &second.items[i];
+        if (!edit_changes_text(&again, e))
+            continue;
+        if (changes++ == 0)
+            fprintf(log, "Not idempotent: %s\n", filename);
+        fprintf(log, "  rule %c changes lines %zu-%zu of the result again\n", 'A' + e->rule,
+                e->start + 1, e->end);
+    }
+    if (changes > 0) {
+        atomic_fetch_add(&ctx->would_change, 1);
+        manifest_add(ctx->manifest, filename, "not-idempotent", changes, NULL, 0);
+    }
+    status = 0;
+done:
+    free_edits(&second);
+    free(again.lines);
+    free(text);
+    return status;
+}
+
+/* process_wants()
+ * Returns false if --shard or --since passes over 'filename'; otherwise true, with *changed set
+ * to the file's changed lines (NULL without --since).
+ */
+static bool process_wants(const char *filename, const struct run_context *ctx,
+                          const struct changed_file **changed) {
+    *changed = NULL;
+    if (ctx->shard && !shard_owns(ctx->shard, filename))
+        return false;
+    if (ctx->changes) {
+        *changed = change_set_find(ctx->changes, filename);
+        if (!*changed)
+            return false;
+    }
+    return true;
+}
+
+/* process_loaded()
+ * The part of process_file() that follows loading: given the file's 'st' and its source 'src'
+ * (which it frees), runs the rules and writes, reports or verifies the result.
+ */
+static int process_loaded(const char *filename, struct run_context *ctx, struct arena *arena,
+                          struct run_stats *stats, FILE *log, const struct changed_file *changed,
+                          const struct stat *st, struct source *src) {
+    src->wrap = ctx->rules.wrap;
+    if (stats) {
+        stats->bytes += src->size;
+        stats->lines += src->count;
+    }
+    uint64_t hash = 0;
+    struct edit_list edits = {0};
+    int status = -1;
+    if (ctx->cache) {
+        hash = xxh64(src->data, src->size, 0);
+        if (cache_hash_matches(ctx->cache, filename, hash)) {
+            cache_mark_clean(ctx->cache, filename, st, hash);
+            free_source(src);
+            if (stats)
+                stats->cached++;
+            return 0;
+        }
+    }
+
+    uint64_t pass_start = now_ns();
+    bool split = ctx->file_jobs > 1 && src->size >= FILE_SPLIT_MIN;
+    if (!(split ? find_edits_split(src, &ctx->rules, ctx->bb, changed, &edits, arena, stats,
+                                   ctx->file_jobs)
+                : find_edits(src, &ctx->rules, ctx->bb, changed, &edits, arena, stats))) {
+        perror("malloc");
+        goto done;
+    }
+    if (ctx->mode == OUTPUT_VERIFY) {
+        atomic_fetch_add(&ctx->pass_ns[0], now_ns() - pass_start);
+        status = verify_fixed_point(filename, src, &edits, ctx, arena, log);
+        goto done;
+    }
+
+    int changes = 0;
+    bool needed = false;
+    for (size_t i = 0; i < edits.count; i++) {
+        bool differs = edit_changes_text(src, &edits.items[i]);
+        needed |= differs;
+        if (ctx->mode == OUTPUT_WRITE ? edits.items[i].text != NULL : differs)
+            changes++;
+    }
+    // A file that needs no changes is never rewritten, even if rules ran and gave back the
+    // same text, so already wrapped files stay clean in the cache.
+    if (!needed) {
+        // With --since only part of the file was looked at.
+        if (ctx->cache && !changed)
+            cache_mark_clean(ctx->cache, filename, st, hash);
+        if (ctx->mode == OUTPUT_WRITE)
+            fprintf(log, "Processed %s: 0 modification(s) made.\n", filename);
+        status = 0;
+        goto done;
+    }
+    if (ctx->mode != OUTPUT_WRITE) {
+        atomic_fetch_add(&ctx->would_change, 1);
+        char *diff = NULL;
+        size_t diff_len = 0;
+        if (ctx->mode == OUTPUT_DIFF && ctx->manifest) {
+            // The manifest keeps a copy of the diff.
+            FILE *mem = open_memstream(&diff, &diff_len);
+            if (!mem) {
+                perror("open_memstream");
+                goto done;
+            }
+            write_unified_diff(mem, filename, src, &edits);
+            fclose(mem);
+            fwrite(diff, 1, diff_len, log);
+        } else if (ctx->mode == OUTPUT_DIFF) {
+            write_unified_diff(log, filename, src, &edits);
+        } else {
+            fprintf(log, "Would reformat %s: %d modification(s).\n", filename, changes);
+        }
+        manifest_add(ctx->manifest, filename, "would-change", changes, diff, diff_len);
+        free(diff);
+        status = 0;
+        goto done;
+    }
+
+    if (replace_file(filename, src, &edits, st, stats, log) != 0)
+        goto done;
+    if (stats)
+        stats->changed++;
+    fprintf(log, "Processed %s: %d modification(s) made.\n", filename, changes);
+    manifest_add(ctx->manifest, filename, "changed", changes, NULL, 0);
+    status = 0;
+done:
+    if (status != 0)
+        manifest_add(ctx->manifest, filename, "failed", 0, NULL, 0);
+    free_edits(&edits);
+    arena_reset(arena);
+    free_source(src);
+    return status;
+}
+
+/* process_file_as()
+ * process_file() (see below) for a file read from 'path' but known as 'name' everywhere else: in the
+ * messages and diff headers, and to the cache, --since, --shard and the manifest. Stdin read
+ * as "/dev/stdin" is reported as "<stdin>", as the streaming path names it.
+ */
+int process_file_as(const char *path, const char *name, struct run_context *ctx,
+                    struct arena *arena, struct run_stats *stats, FILE *log) {
+    const struct changed_file *changed;
+    if (!process_wants(name, ctx, &changed))
+        return 0;
+    struct stat st;
+    if (stats)
+        stats->files++;
+    if (stat(path, &st) == -1) {
+        perror(path);
+        manifest_add(ctx->manifest, name, "failed", 0, NULL, 0);
+        return -1;
+    }
+    if (ctx->cache) {
+        if (cache_stat_matches(ctx->cache, name, &st)) {
+            if (stats)
+                stats->cached++;
+            return 0;
+        }
+    }
+    uint64_t t = stats ? now_ns() : 0;
+    struct source src;
+    if (load_source(path, ctx->rules.width, &src) != 0) {
+        manifest_add(ctx->manifest, name, "failed", 0, NULL, 0);
+        return -1;
+    }
+    if (stats)
+        stats->read_ns += now_ns() - t;
+    return process_loaded(name, ctx, arena, stats, log, changed, &st, &src);
+}
+
+/* process_file()
+ * Processes a single Python file by mapping it into memory, applying the transformation rules,
+ * and then writing the modified content back to the file. The rules record their results as edits;
+ * Rule A snippets are submitted to the Black workers in chunks as the scan finds them, so Black
+ * runs while the other rules go on, and are collected in line order once the scan is done.
+ * Files without any change are left untouched; with a cache, files recorded as clean are skipped
+ * without being read (same size and mtime) or without being processed (same content hash).
+ * Rule output is allocated from 'arena', which is reset before returning. Unless 'stats' is
+ * NULL, each stage is timed and counted there. In --check and --diff mode nothing is written:
+ * files whose output would differ from the input are counted and reported or diffed to 'log'.
+ * With --verify-idempotent, the result is checked with verify_fixed_point() instead.
+ * With --since, only edits overlapping the file's changed lines are kept, and files without
+ * changed lines are not opened; with --shard, files of other shards are passed over the same
+ * way. Every file that changes, would change or fails is recorded in the --emit-manifest file.
+ * Progress messages go to 'log'. Returns 0 on success and -1 if the file could not be processed.
+ */
+int process_file(const char *filename, struct run_context *ctx, struct arena *arena,
+                 struct run_stats *stats, FILE *log) {
+    return process_file_as(filename, filename, ctx, arena, stats, log);
+}
+
+// ----------------- Streaming -----------------
+
+/* struct stream
+ * Bounded lookahead window over an input stream. 'win' indexes the complete lines held in
+ * buf[0, indexed); bytes in buf[indexed, size) belong to a line whose end has not been read yet.
+ * Lines leave the window as soon as the rules are done with them.
+ */
+struct stream {
+    FILE *in;
+    char *buf;
+    size_t size, capacity, indexed;
+    bool eof;
+    struct source win;
+    size_t lines_capacity;
+    size_t base_line; /* input line number of win.lines[0], from 0 */
+    struct token_state tok;
+};
+
+/* stream_read_line()
+ * Adds the next input line to the window. Returns false at end of input.
+ */
+static bool stream_read_line(struct stream *st) {
+    for (;;) {
+        const char *nl = memchr(st->buf + st->indexed, '\n', st->size - st->indexed);
+        size_t end = nl ? (size_t)(nl - st->buf) + 1 : st->size;
+        if (nl || (st->eof && st->indexed < st->size)) {
+            if (st->win.count >= st->lines_capacity) {
+                size_t capacity = (st->lines_capacity == 0) ? 64 : st->lines_capacity * 2;
+                struct line_span *tmp = realloc(st->win.lines, capacity * sizeof(struct line_span));
+                if (!tmp) {
+                    perror("realloc");
+                    return false;
+                }
+                st->win.lines = tmp;
+                st->lines_capacity = capacity;
+            }
+            st->win.lines[st->win.count].off = st->indexed;
+            st->win.lines[st->win.count].len = end - st->indexed;
+            tokenize_line(&st->tok, &st->win, st->win.count,
+                          raw_line_flags(st->buf + st->indexed, end - st->indexed));
+            st->win.count++;
+            st->indexed = end;
+            return true;
+        }
+        if (st->eof)
+            return false;
+        if (st->capacity - st->size < BUFFER_SIZE) {
+            size_t capacity = (st->capacity == 0) ? 4 * BUFFER_SIZE : st->capacity * 2;
+            char *tmp = realloc(st->buf, capacity);
+            if (!tmp) {
+                perror("realloc");
+                return false;
+            }
+            st->buf = tmp;
+            st->capacity = capacity;
+            st->win.data = st->buf;
+        }
+        size_t n = fread(st->buf + st->size, 1, st->capacity - st->size, st->in);
+        st->size += n;
+        if (n == 0)
+            st->eof = true;
+    }
+}
+
+/* stream_read_until()
+ * Extends the window until one of its lines after the first satisfies 'done', or the input
+ * ends. This is all the lookahead a Rule C or Rule D block at the head of the window needs.
+ */
+static void stream_read_until(struct stream *st, bool (*done)(unsigned flags)) {
+    size_t j = 1;
+    for (;;) {
+        for (; j < st->win.count; j++) {
+            if (done(st->win.lines[j].flags))
+                return;
+        }
+        if (!stream_read_line(st))
+            return;
+    }
+}
+
+static bool closes_triple_quote(unsigned flags) {
+    return (flags & LINE_TQ) != 0;
+}
+
+static bool ends_comment_run(unsigned flags) {
+    return !(flags & LINE_COMMENT);
+}
+
+/* stream_drop()
+ * Removes the first n lines from the window and moves the remaining bytes to the front.
+ */
+static void stream_drop(struct stream *st, size_t n) {
+    size_t shift = (n < st->win.count) ? st->win.lines[n].off : st->indexed;
+    memmove(st->buf, st->buf + shift, st->size - shift);
+    st->size -= shift;
+    st->indexed -= shift;
+    st->win.count -= n;
+    memmove(st->win.lines, st->win.lines + n, st->win.count * sizeof(struct line_span));
+    for (size_t i = 0; i < st->win.count; i++)
+        st->win.lines[i].off -= shift;
+    st->base_line += n;
+    if (st->tok.opener != NO_LINE)
+        st->tok.opener = (st->tok.opener >= n) ? st->tok.opener - n : NO_LINE;
+}
+
+/* process_stream()
+ * Applies the rules to 'in' in a single pass and writes the result to 'out'. Only the block at
+ * the head of the input (an open triple-quoted block or comment run) is held in memory; every
+ * finished line is written out immediately. Rule A snippets are formatted one at a time.
+ * Rule output goes to an arena that is reset after every emitted block.
+ * Progress messages go to 'log'. Returns 0 on success and -1 on a read or write error.
+ */
+int process_stream(FILE *in, FILE *out, const char *name, struct run_context *ctx, FILE *log) {
+    struct stream st = {0};
+    st.in = in;
+    st.tok = (struct token_state)TOKEN_STATE_INIT;
+    st.win.width = ctx->rules.width;
+    st.win.wrap = ctx->rules.wrap;
+    struct arena arena = {0};
+    struct run_stats *stats = ctx->stats;
+    int changes = 0;
+    while (st.win.count > 0 || stream_read_line(&st)) {
+        size_t len = st.win.lines[0].len;
+        unsigned flags = st.win.lines[0].flags;
+        if (flags & LINE_TQ_START)
+            stream_read_until(&st, closes_triple_quote);
+        else if ((flags & LINE_COMMENT) && len > (size_t)st.win.width)
+            stream_read_until(&st, ends_comment_run);
+        struct edit e;
+        if (ctx->rules.apply(&st.win, 0, &e, &arena, stats ? &stats->rules : NULL) && e.snippet) {
+            char *formatted;
+            struct black_job job = {.snippets = &e.snippet, .results = &formatted, .n = 1};
+            black_submit(ctx->bb, &job);
+            black_wait(ctx->bb, &job);
+            if (stats)
+                stats_black_job(stats, &job);
+            if (formatted) {
+                e.text = build_print_block(formatted, e.indent, &arena);
+            } else {
+                fprintf(stderr, "Error: Failed to run black. Ensure it is in your PATH.\n");
+                print_fallback(&st.win, &ctx->rules, &e, &arena, stats ? &stats->rules : NULL);
+            }
+        }
+        size_t used = e.text ? e.end - e.start : 1;
+        if (stats) {
+            for (size_t k = 0; k < used; k++)
+                stats->bytes += st.win.lines[k].len;
+            stats->lines += used;
+        }
+        if (e.text) {
+            e.start += st.base_line;
+            e.end += st.base_line;
+            report_edit(log, name, &e);
+            fputs(e.text, out);
+            changes++;
+        } else {
+            // The lookahead may have moved the buffer.
+            fwrite(st.win.data + st.win.lines[0].off, 1, len, out);
+        }
+        stream_drop(&st, used);
+        arena_reset(&arena);
+    }
+    int status = 0;
+    if (ferror(in)) {
+        perror(name);
+        status = -1;
+    }
+    if (fflush(out) != 0 || ferror(out)) {
+        perror("write");
+        status = -1;
+    }
+    free(st.buf);
+    free(st.win.lines);
+    arena_free(&arena);
+    if (stats) {
+        stats->files++;
+        stats->changed += (changes > 0);
+    }
+    if (status == 0)
+        fprintf(log, "Processed %s: %d modification(s) made.\n", name, changes);
+    return status;
+}
+
+// ----------------- Library -----------------
+
+/* struct reflow_black
+ * The Black backend behind a library handle (see reflow.h).
+ */
+struct reflow_black {
+    struct black_backend bb;
+};
+
+_Static_assert(REFLOW_RULE_A == RULE_BIT(RULE_A) && REFLOW_RULE_B == RULE_BIT(RULE_B) &&
+               REFLOW_RULE_C == RULE_BIT(RULE_C) && REFLOW_RULE_D == RULE_BIT(RULE_D),
+               "REFLOW_RULE_* must match RULE_BIT()");
+
+struct reflow_black *reflow_black_start(int workers) {
+    return reflow_black_start_width(workers, MAX_LEN);
+}
+
+struct reflow_black *reflow_black_start_width(int workers, int line_length) {
+    struct reflow_black *black = malloc(sizeof(*black));
+    if (!black)
+        return NULL;
+    if (!black_start(&black->bb, workers < 1 ? 1 : workers, line_length > 0 ? line_length : MAX_LEN)) {
+        if (!check_black_available()) {
+            reflow_black_stop(black);
+            return NULL;
+        }
+        black_cli_version(&black->bb);
+    }
+    return black;
+}
+
+void reflow_black_stop(struct reflow_black *black) {
+    if (!black)
+        return;
+    struct black_backend *bb = &black->bb;
+    black_stop(bb);
+    pthread_mutex_destroy(&bb->memo.lock);
+    pthread_cond_destroy(&bb->finished);
+    pthread_cond_destroy(&bb->queued);
+    pthread_mutex_destroy(&bb->lock);
+    free(black);
+}
+
+int reflow_buffer(const char *in, size_t len, const struct reflow_opts *opts,
+                  struct reflow_result *result) {
+    static const struct reflow_opts defaults = {0};
+    if (!opts)
+        opts = &defaults;
+    memset(result, 0, sizeof(*result));
+    struct rule_set rules;
+    rule_set_init(&rules, opts->rules ? opts->rules : RULES_ALL,
+                  opts->line_length > 0 ? opts->line_length : MAX_LEN,
+                  opts->wrap == REFLOW_WRAP_OPTIMAL ? WRAP_OPTIMAL : WRAP_GREEDY);
+    struct black_backend *bb = opts->black ? &opts->black->bb : NULL;
+    if (bb && bb->line_length != rules.width) {
+        errno = EINVAL;
+        return -1;
+    }
+    struct source src = {.data = in, .size = len, .width = rules.width, .wrap = rules.wrap,
+                         .fd = -1};
+    if (scan_source(&src) != 0)
+        return -1;
+    struct arena arena = {.allocator = opts->allocator};
+    struct edit_list edits = {0};
+    int status = -1;
+    if (!find_edits(&src, &rules, bb, NULL, &edits, &arena, NULL))
+        goto done;
+    for (size_t i = 0; i < edits.count; i++)
+        if (edit_changes_text(&src, &edits.items[i]))
+            result->changes++;
+    // An unchanged buffer is not copied at all.
+    if (result->changes > 0) {
+        size_t n = render_edits(&src, &edits, NULL);
+        const struct reflow_allocator *a = opts->allocator;
+        result->text = a ? a->alloc(n + 1, a->ctx) : malloc(n + 1);
+        if (!result->text) {
+            result->changes = 0;
+            errno = ENOMEM;
+            goto done;
+        }
+        render_edits(&src, &edits, result->text);
+        result->text[n] = '\0';
+        result->len = n;
+    }
+    status = 0;
+done:
+    free_edits(&edits);
+    arena_free(&arena);
+    free(src.lines);
+    return status;
+}
+
+void reflow_result_free(struct reflow_result *result, const struct reflow_opts *opts) {
+    const struct reflow_allocator *a = opts ? opts->allocator : NULL;
+    if (result->text) {
+        if (a)
+            a->release(result->text, a->ctx);
+        else
+            free(result->text);
+    }
+    memset(result, 0, sizeof(*result));
+}
+
+// ----------------- Directory Walking -----------------
+
+/* struct walk_options
+ * What the directory walk leaves out. Unless 'no_ignore' is set, directories named in
+ * pruned_dirs[] are skipped and the .gitignore files found along the way are honored.
+ * Every entry whose name (or, for patterns with a '/', path below the walked directory)
+ * matches one of the 'excludes' globs is skipped as well.
+ */
+struct walk_options {
+    const char **excludes;
+    size_t nexcludes;
+    bool no_ignore;
+};
+
+static const char *const pruned_dirs[] = {".git", ".hg", ".svn", "node_modules", "__pycache__"};
+
+/* struct ignore_rule
+ * One .gitignore pattern. Anchored patterns (with a '/' other than a trailing one) match the
+ * path below the .gitignore's directory; the others match the entry's name.
+ */
+struct ignore_rule {
+    char *pattern;
+    bool negate, dir_only, anchored;
+};
+
+/* struct ignore_list
+ * The rules of one .gitignore file, linked to those of the directories above it. Lists are
+ * shared by every directory below theirs, possibly walked by other threads, and are freed
+ * when the last reference goes.
+ */
+struct ignore_list {
+    struct ignore_list *parent;
+    atomic_int refs;
+    size_t base_len; /* length of the path of the directory holding the .gitignore */
+    struct ignore_rule *rules;
+    size_t count;
+};
+
+static struct ignore_list *ignore_ref(struct ignore_list *list) {
+    if (list)
+        atomic_fetch_add(&list->refs, 1);
+    return list;
+}
+
+static void ignore_unref(struct ignore_list *list) {
+    while (list && atomic_fetch_sub(&list->refs, 1) == 1) {
+        struct ignore_list *parent = list->parent;
+        for (size_t i = 0; i < list->count; i++)
+            free(list->rules[i].pattern);
+        free(list->rules);
+        free(list);
+        list = parent;
+    }
+}
+
+/* ignore_load()
+ * Reads the .gitignore in directory 'fd' (whose path is base_len bytes long) and returns its
+ * rules on top of 'parent', or a new reference to 'parent' if there are none or the file
+ * cannot be read. Supports comments, "!" negation, trailing "/" for directories, anchoring
+ * and a leading "**" + "/"; "**" in the middle of a pattern only matches one level.
+ */
+static struct ignore_list *ignore_load(int fd, size_t base_len, struct ignore_list *parent) {
+    int gfd = openat(fd, ".gitignore", O_RDONLY | O_CLOEXEC);
+    FILE *fp = (gfd == -1) ? NULL : fdopen(gfd, "r");
+    if (!fp) {
+        if (gfd != -1)
+            close(gfd);
+        return ignore_ref(parent);
+    }
+    struct ignore_list *list = calloc(1, sizeof(*list));
+    size_t capacity = 0;
+    char line[BUFFER_SIZE];
+    while (list && fgets(line, sizeof(line), fp)) {
+        strip_crlf(line);
+        rtrim(line);
+        char *p = line;
+        if (!*p || *p == '#')
+            continue;
+        struct ignore_rule rule = {0};
+        if (*p == '!') {
+            rule.negate = true;
+            p++;
+        } else if (*p == '\\') {
+            p++;  // "\#" and "\!" stand for themselves.
+        }
+        size_t len = strlen(p);
+        if (len > 0 && p[len-1] == '/') {
+            rule.dir_only = true;
+            p[--len] = '\0';
+        }
+        if (strncmp(p, "**/", 3) == 0)
+            p += 3;
+        else if (strchr(p, '/'))
+            rule.anchored = true;
+        if (*p == '/')
+            p++;
+        if (!*p)
+            continue;
+        if (list->count >= capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            struct ignore_rule *tmp = realloc(list->rules, capacity * sizeof(*tmp));
+            if (!tmp)
+                break;
+            list->rules = tmp;
+        }
+        rule.pattern = strdup(p);
+        if (!rule.pattern)
+            break;
+        list->rules[list->count++] = rule;
+    }
+    fclose(fp);
+    if (!list || list->count == 0) {
+        if (list)
+            free(list->rules);
+        free(list);
+        return ignore_ref(parent);
+    }
+    list->parent = ignore_ref(parent);
+    atomic_init(&list->refs, 1);
+    list->base_len = base_len;
+    return list;
+}
+
+/* ignore_match()
+ * Returns true if the entry at 'path' (called 'name') is ignored by the nearest .gitignore
+ * rule that matches it: later rules override earlier ones, deeper files the ones above them.
+ */
+static bool ignore_match(const struct ignore_list *list, const char *path, const char *name, bool is_dir) {
+    for (; list; list = list->parent) {
+        const char *rel = path + list->base_len + 1;
+        for (size_t i = list->count; i-- > 0; ) {
+            const struct ignore_rule *r = &list->rules[i];
+            if (r->dir_only && !is_dir)
+                continue;
+            if (fnmatch(r->pattern, r->anchored ? rel : name, r->anchored ? FNM_PATHNAME : 0) == 0)
+                return !r->negate;
+        }
+    }
+    return false;
+}
+
+/* struct walker
+ * One thread's share of a walk. Files are passed to visit(); if 'offer' is set, every
+ * subdirectory is first offered to it, and walked here only if it declines. If 'enter' is
+ * set, it is told about every directory walked, with the ignore rules that apply inside it.
+ */
+struct walker {
+    const struct walk_options *opts;
+    size_t root_len;
+    int (*visit)(const char *path, void *arg);
+    bool (*offer)(const char *path, struct ignore_list *ignore, void *arg);
+    int (*enter)(const char *path, const struct ignore_list *ignore, void *arg);
+    void *arg;
+};
+
+/* walk_skips()
+ * Returns true if the options leave the entry out of the walk.
+ */
+static bool walk_skips(const struct walker *w, const char *path, const char *name, bool is_dir,
+                       const struct ignore_list *ignore) {
+    const struct walk_options *opts = w->opts;
+    const char *rel = path + w->root_len + 1;
+    for (size_t i = 0; i < opts->nexcludes; i++) {
+        const char *pattern = opts->excludes[i];
+        if (fnmatch(pattern, strchr(pattern, '/') ? rel : name, 0) == 0)
+            return true;
+    }
+    if (opts->no_ignore)
+        return false;
+    if (is_dir) {
+        for (size_t i = 0; i < sizeof(pruned_dirs) / sizeof(pruned_dirs[0]); i++)
+            if (strcmp(name, pruned_dirs[i]) == 0)
+                return true;
+    }
+    return ignore_match(ignore, path, name, is_dir);
+}
+
+/* struct dir_listing
+ * The entries of a directory, packed as a d_type byte followed by the NUL-terminated name.
+ */
+struct dir_listing {
+    char *data;
+    size_t size, capacity;
+};
+
+static bool listing_add(struct dir_listing *l, unsigned char type, const char *name) {
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+        return true;
+    size_t n = strlen(name) + 2;
+    if (l->size + n > l->capacity) {
+        size_t capacity = l->capacity ? l->capacity * 2 : 4096;
+        while (capacity < l->size + n)
+            capacity *= 2;
+        char *tmp = realloc(l->data, capacity);
+        if (!tmp)
+            return false;
+        l->data = tmp;
+        l->capacity = capacity;
+    }
+    l->data[l->size] = (char)type;
+    memcpy(l->data + l->size + 1, name, n - 1);
+    l->size += n;
+    return true;
+}
+
+#ifdef __linux__
+struct linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+#endif
+
+/* read_listing()
+ * Reads every entry of directory 'fd' except "." and "..": with getdents64() in large chunks
+ * on Linux, through readdir() elsewhere. Returns false (with errno set) on failure.
+ */
+static bool read_listing(int fd, struct dir_listing *l) {
+#ifdef __linux__
+    _Alignas(8) char buf[32 * 1024];
+    for (;;) {
+        long n = syscall(SYS_getdents64, fd, buf, sizeof(buf));
+        if (n == -1)
+            return false;
+        if (n == 0)
+            return true;
+        for (long off = 0; off < n; ) {
+            const struct linux_dirent64 *d = (const struct linux_dirent64 *)(buf + off);
+            if (!listing_add(l, d->d_type, d->d_name))
+                return false;
+            off += d->d_reclen;
+        }
+    }
+#else
+    int dup_fd = dup(fd);
+    DIR *dir = (dup_fd == -1) ? NULL : fdopendir(dup_fd);
+    if (!dir) {
+        if (dup_fd != -1)
+            close(dup_fd);
+        return false;
+    }
+    struct dirent *entry;
+    bool ok = true;
+    while (ok && (errno = 0, entry = readdir(dir)) != NULL)
+        ok = listing_add(l, entry->d_type, entry->d_name);
+    ok = ok && errno == 0;
+    closedir(dir);
+    return ok;
+#endif
+}
+
+static bool is_python_file(const char *name) {
+    const char *ext = strrchr(name, '.');
+    return ext && strcmp(ext, ".py") == 0;
+}
+
+/* walk_dir()
+ * Walks directory 'fd', whose path is 'path', below the ignore rules 'ignore'. Entry types come
+ * from d_type, so only symlinks and file systems that do not report types cost an fstatat();
+ * other files are never stat'ed unless they end in ".py". Subdirectories are opened with
+ * openat() relative to 'fd'; symlinks to directories are not followed, so a link back up the
+ * tree cannot make the walk loop. Returns -1 if some entry could not be read, 0 otherwise.
+ */
+static int walk_dir(struct walker *w, int fd, const char *path, struct ignore_list *ignore) {
+    struct dir_listing listing = {0};
+    if (!read_listing(fd, &listing)) {
+        perror(path);
+        free(listing.data);
+        return -1;
+    }
+    size_t path_len = strlen(path);
+    char *child = malloc(path_len + 2 + NAME_MAX + 1);
+    if (!child) {
+        perror("malloc");
+        free(listing.data);
+        return -1;
+    }
+    memcpy(child, path, path_len);
+    child[path_len] = '/';
+    ignore = w->opts->no_ignore ? ignore_ref(ignore) : ignore_load(fd, path_len, ignore);
+    int status = 0;
+    if (w->enter && w->enter(path, ignore, w->arg) != 0)
+        status = -1;
+    for (size_t off = 0; off < listing.size; ) {
+        unsigned char type = (unsigned char)listing.data[off];
+        const char *name = listing.data + off + 1;
+        size_t name_len = strlen(name);
+        off += name_len + 2;
+        if (name_len > NAME_MAX)
+            continue;
+        if (type == DT_REG && !is_python_file(name))
+            continue;
+        memcpy(child + path_len + 1, name, name_len + 1);
+        if (type != DT_REG && type != DT_DIR) {
+            struct stat st;
+            bool link = false;
+            if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == -1 ||
+                ((link = S_ISLNK(st.st_mode)) && fstatat(fd, name, &st, 0) == -1)) {
+                perror(child);
+                status = -1;
+                continue;
+            }
+            // A symlinked directory is not entered: it may lead back up the tree.
+            if (link && S_ISDIR(st.st_mode))
+                continue;
+            type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN;
+            if (type == DT_UNKNOWN || (type == DT_REG && !is_python_file(name)))
+                continue;
+        }
+        bool is_dir = (type == DT_DIR);
+        if (walk_skips(w, child, name, is_dir, ignore))
+            continue;
+        if (!is_dir) {
+            if (w->visit(child, w->arg) != 0)
+                status = -1;
+            continue;
+        }
+        if (w->offer && w->offer(child, ignore, w->arg))
+            continue;
+        int sub = openat(fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (sub == -1) {
+            perror(child);
+            status = -1;
+            continue;
+        }
+        if (walk_dir(w, sub, child, ignore) != 0)
+            status = -1;
+        close(sub);
+    }
+    ignore_unref(ignore);
+    free(child);
+    free(listing.data);
+    return status;
+}
+
+/* walk_subtree()
+ * Opens the directory 'path' (which lies below the walk's root) and walks it.
+ */
+static int walk_subtree(struct walker *w, const char *path, struct ignore_list *ignore) {
+    int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1) {
+        perror(path);
+        return -1;
+    }
+    int status = walk_dir(w, fd, path, ignore);
+    close(fd);
+    return status;
+}
+
+/* walk_directory()
+ * Recursively finds all files with a ".py" extension in the given directory, leaving out what
+ * 'opts' excludes, and calls visit(path, arg) for each of them. Returns -1 if some entry could
+ * not be read, 0 otherwise.
+ */
+int walk_directory(const char *dir_path, const struct walk_options *opts,
+                   int (*visit)(const char *path, void *arg), void *arg) {
+    struct walker w = {opts, strlen(dir_path), visit, NULL, NULL, arg};
+    return walk_subtree(&w, dir_path, NULL);
+}
+
+/* struct serial_run
+ * State of a sequential directory run: the shared context and the arena reused by every file.
+ */
+struct serial_run {
+    struct run_context *ctx;
+    struct arena arena;
+};
+
+/* walk_targets()
+ * Calls visit(path, arg) for every file to process under dir_path: the changed .py files with
+ * --since (without reading any directory), otherwise everything walk_directory() finds.
+ */
+int walk_targets(const char *dir_path, struct run_context *ctx,
+                 int (*visit)(const char *path, void *arg), void *arg) {
+    if (!ctx->changes)
+        return walk_directory(dir_path, ctx->walk, visit, arg);
+    int status = 0;
+    for (size_t i = 0; i < ctx->changes->count; i++) {
+        const char *path = ctx->changes->files[i].path;
+        struct stat st;
+        if (stat(path, &st) == -1) {
+            perror(path);
+            status = -1;
+        } else if (S_ISREG(st.st_mode) && visit(path, arg) != 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+static int visit_process_file(const char *path, void *arg) {
+    struct serial_run *run = arg;
+    return process_file(path, run->ctx, &run->arena, run->ctx->stats, stdout);
+}
+
+/* process_directory()
+ * Recursively processes all files with a ".py" extension in the given directory, one at a time.
+ */
+int process_directory(const char *dir_path, struct run_context *ctx) {
+    struct serial_run run = {.ctx = ctx};
+    int status = walk_targets(dir_path, ctx, visit_process_file, &run);
+    arena_free(&run.arena);
+    return status;
+}
+
+// ----------------- Parallel Scheduler -----------------
+
+#define SCHED_LARGE_MIN (256u << 10)   // files from this size on are taken largest first
+#define SCHED_BATCH_FILES 32           // most small files a worker takes at once
+#define SCHED_BATCH_BYTES (256u << 10) // ... and the most bytes they may add up to
+
+/* struct queued_file
+ * A path waiting to be processed, and its size when it was queued.
+ */
+struct queued_file {
+    char *path;
+    uint64_t size;
+};
+
+/* struct file_deque
+ * One worker's share of the queued small files. The owner takes work from the tail; idle
+ * workers steal from the head, so a thief and the owner rarely contend for the same end.
+ */
+struct file_deque {
+    pthread_mutex_t lock;
+    struct queued_file *files;
+    size_t head, tail, capacity;
+};
+
+/* struct file_heap
+ * The queued files of at least SCHED_LARGE_MIN bytes, shared by all workers as a max-heap by
+ * size. Workers take from it before anything else, so the biggest files start early instead
+ * of being left to run on their own at the end of the walk.
+ */
+struct file_heap {
+    pthread_mutex_t lock;
+    struct queued_file *files;
+    size_t count, capacity;
+    atomic_size_t queued; /* 'count', readable without the lock */
+};
+
+/* struct dir_task
+ * A directory handed to an idle worker to walk, with the ignore rules that apply inside it.
+ */
+struct dir_task {
+    char *path;
+    struct ignore_list *ignore;
+    struct dir_task *next;
+};
+
+/* struct scheduler
+ * Work shared by the workers: files to process in per-worker deques, and directories still to
+ * be walked. Workers walk and process at the same time; a worker walking a tree queues the
+ * files it finds on its own deque, and hands subdirectories to the shared queue while other
+ * workers are idle.
+ */
+struct scheduler {
+    struct file_deque *deques;
+    struct file_heap large;
+    int nworkers;
+    int next_push; /* round-robin target when the files are queued up front (--since) */
+    struct run_context *ctx;
+    size_t root_len;
+    pthread_mutex_t output_lock;
+    pthread_mutex_t walk_lock; /* guards 'dirs' and 'walking' */
+    pthread_cond_t work;       /* a directory or file was queued, or the walk is over */
+    struct dir_task *dirs;
+    int walking;               /* directories queued or being walked */
+    atomic_int idle;           /* workers waiting in scheduler_wait() */
+    atomic_long pending;       /* files in the deques and the heap */
+#ifdef __linux__
+    cpu_set_t *nodes;          /* usable CPUs of each NUMA node; NULL on a single-node machine */
+    int nnodes;
+#endif
+};
+
+#ifdef REFLOW_IO_URING
+#define URING_ENTRIES (2 * SCHED_BATCH_FILES) // an open and a statx for every file of a batch
+
+/* struct uring
+ * A worker's io_uring, set up with the raw system calls rather than through liburing: the
+ * mapped submission and completion rings and the array of submission entries. 'fd' is -1 if
+ * the kernel refused to create a ring (too old, or io_uring disabled), and the worker then
+ * loads its files with load_source().
+ */
+struct uring {
+    int fd;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_map, *cq_map;
+    size_t sq_len, cq_len, sqes_len;
+    unsigned unsubmitted; /* entries filled in since the last uring_submit() */
+};
+#endif
+
+struct worker {
+    struct scheduler *sched;
+    int id;
+    int node;               /* NUMA node the thread runs on, or -1 to leave it unpinned */
+    int status;
+    struct arena arena;
+#ifdef REFLOW_IO_URING
+    struct uring ring;
+#endif
+    struct run_stats stats; /* merged into the run's totals after the join */
+    pthread_t thread;
+};
+
+/* deque_push()
+ * Appends 'file' to the tail of the deque. Returns -1 on allocation failure.
+ */
+static int deque_push(struct file_deque *dq, struct queued_file file) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail >= dq->capacity) {
+        size_t capacity = (dq->capacity == 0) ? 256 : dq->capacity * 2;
+        struct queued_file *tmp = realloc(dq->files, capacity * sizeof(*tmp));
+        if (!tmp) {
+            pthread_mutex_unlock(&dq->lock);
+            return -1;
+        }
+        dq->files = tmp;
+        dq->capacity = capacity;
+    }
+    dq->files[dq->tail++] = file;
+    pthread_mutex_unlock(&dq->lock);
+    return 0;
+}
+
+/* deque_take()
+ * Removes a batch of files from the tail (owner) or the head (thief) into 'batch': at least
+ * one, and then more while they stay within SCHED_BATCH_FILES and SCHED_BATCH_BYTES. Returns
+ * how many were taken, 0 when the deque is empty.
+ */
+static size_t deque_take(struct file_deque *dq, bool steal, struct queued_file *batch) {
+    size_t n = 0;
+    uint64_t bytes = 0;
+    pthread_mutex_lock(&dq->lock);
+    while (dq->head < dq->tail && n < SCHED_BATCH_FILES) {
+        const struct queued_file *f = steal ? &dq->files[dq->head] : &dq->files[dq->tail - 1];
+        if (n > 0 && bytes + f->size > SCHED_BATCH_BYTES)
+            break;
+        bytes += f->size;
+        batch[n++] = *f;
+        if (steal)
+            dq->head++;
+        else
+            dq->tail--;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return n;
+}
+
+/* heap_push()
+ * Adds 'file' to the heap of large files. Returns -1 on allocation failure.
+ */
+static int heap_push(struct file_heap *h, struct queued_file file) {
+    pthread_mutex_lock(&h->lock);
+    if (h->count == h->capacity) {
+        size_t capacity = h->capacity ? h->capacity * 2 : 64;
+        struct queued_file *tmp = realloc(h->files, capacity * sizeof(*tmp));
+        if (!tmp) {
+            pthread_mutex_unlock(&h->lock);
+            return -1;
+        }
+        h->files = tmp;
+        h->capacity = capacity;
+    }
+    size_t i = h->count++;
+    for (; i > 0 && h->files[(i - 1) / 2].size < file.size; i = (i - 1) / 2)
+        h->files[i] = h->files[(i - 1) / 2];
+    h->files[i] = file;
+    atomic_store(&h->queued, h->count);
+    pthread_mutex_unlock(&h->lock);
+    return 0;
+}
+
+/* heap_take()
+ * Removes the largest file from the heap into *file. Returns false when the heap is empty.
+ */
+static bool heap_take(struct file_heap *h, struct queued_file *file) {
+    if (atomic_load(&h->queued) == 0)
+        return false;
+    pthread_mutex_lock(&h->lock);
+    bool found = h->count > 0;
+    if (found) {
+        *file = h->files[0];
+        struct queued_file last = h->files[--h->count];
+        size_t i = 0;
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= h->count)
+                break;
+            if (child + 1 < h->count && h->files[child + 1].size > h->files[child].size)
+                child++;
+            if (h->files[child].size <= last.size)
+                break;
+            h->files[i] = h->files[child];
+            i = child;
+        }
+        if (h->count > 0)
+            h->files[i] = last;
+        atomic_store(&h->queued, h->count);
+    }
+    pthread_mutex_unlock(&h->lock);
+    return found;
+}
+
+/* scheduler_push()
+ * Queues a file, on the heap if it is large and on deque 'id' otherwise, and wakes idle
+ * workers, if any, to take it. An idle worker announces itself before it checks 'pending',
+ * and the pusher counts the file before it checks 'idle', so one of them always sees the other.
+ * A file that cannot be stat'ed is queued anyway, for process_file() to report.
+ */
+static int scheduler_push(struct scheduler *sched, int id, const char *path) {
+    struct stat st;
+    struct queued_file file = {strdup(path), stat(path, &st) == 0 ? (uint64_t)st.st_size : 0};
+    if (!file.path ||
+        (file.size >= SCHED_LARGE_MIN ? heap_push(&sched->large, file)
+                                      : deque_push(&sched->deques[id], file)) != 0) {
+        perror("realloc");
+        free(file.path);
+        return -1;
+    }
+    atomic_fetch_add(&sched->pending, 1);
+    if (atomic_load(&sched->idle) > 0) {
+        pthread_mutex_lock(&sched->walk_lock);
+        pthread_cond_broadcast(&sched->work);
+        pthread_mutex_unlock(&sched->walk_lock);
+    }
+    return 0;
+}
+
+static int visit_queue_file(const char *path, void *arg) {
+    struct scheduler *sched = arg;
+    int id = sched->next_push;
+    sched->next_push = (sched->next_push + 1) % sched->nworkers;
+    return scheduler_push(sched, id, path);
+}
+
+/* scheduler_next()
+ * Fills 'batch' with the next work for worker 'id': the largest queued large file, or else a
+ * batch of small files from its own deque or, failing that, stolen from the other workers.
+ * Returns the number of files, 0 if there are none right now.
+ */
+static size_t scheduler_next(struct scheduler *sched, int id, struct queued_file *batch) {
+    size_t n = heap_take(&sched->large, batch) ? 1 : deque_take(&sched->deques[id], false, batch);
+    for (int k = 1; n == 0 && k < sched->nworkers; k++)
+        n = deque_take(&sched->deques[(id + k) % sched->nworkers], true, batch);
+    if (n > 0)
+        atomic_fetch_sub(&sched->pending, (long)n);
+    return n;
+}
+
+/* scheduler_offer_dir()
+ * Walk callback: hands a subdirectory to the shared queue if some worker is idle, so that
+ * subtrees are walked in parallel. Returns false if the caller should walk it itself.
+ */
+static bool scheduler_offer_dir(const char *path, struct ignore_list *ignore, void *arg);
+
+/* scheduler_wait()
+ * Waits until there is a directory to walk, a file to take, or nothing left at all. Returns
+ * the directory if there is one; otherwise NULL, with *done set if the run is over.
+ */
+static struct dir_task *scheduler_wait(struct scheduler *sched, bool *done) {
+    pthread_mutex_lock(&sched->walk_lock);
+    atomic_fetch_add(&sched->idle, 1);
+    while (!sched->dirs && sched->walking > 0 && atomic_load(&sched->pending) <= 0)
+        pthread_cond_wait(&sched->work, &sched->walk_lock);
+    atomic_fetch_sub(&sched->idle, 1);
+    struct dir_task *task = sched->dirs;
+    if (task)
+        sched->dirs = task->next;
+    *done = !task && sched->walking == 0 && atomic_load(&sched->pending) <= 0;
+    pthread_mutex_unlock(&sched->walk_lock);
+    return task;
+}
+
+/* scheduler_add_dir()
+ * Queues directory 'path' to be walked with the ignore rules 'ignore'. Returns false on
+ * allocation failure.
+ */
+static bool scheduler_add_dir(struct scheduler *sched, const char *path, struct ignore_list *ignore) {
+    struct dir_task *task = malloc(sizeof(*task));
+    char *copy = strdup(path);
+    if (!task || !copy) {
+        free(task);
+        free(copy);
+        return false;
+    }
+    task->path = copy;
+    task->ignore = ignore_ref(ignore);
+    pthread_mutex_lock(&sched->walk_lock);
+    task->next = sched->dirs;
+    sched->dirs = task;
+    sched->walking++;
+    pthread_cond_signal(&sched->work);
+    pthread_mutex_unlock(&sched->walk_lock);
+    return true;
+}
+
+/* scheduler_walked()
+ * Marks a queued directory as walked and frees its task. Once the last one is done, the
+ * waiting workers are woken so that they can finish.
+ */
+static void scheduler_walked(struct scheduler *sched, struct dir_task *task) {
+    pthread_mutex_lock(&sched->walk_lock);
+    if (--sched->walking == 0)
+        pthread_cond_broadcast(&sched->work);
+    pthread_mutex_unlock(&sched->walk_lock);
+    ignore_unref(task->ignore);
+    free(task->path);
+    free(task);
+}
+
+static int visit_walked_file(const char *path, void *arg) {
+    struct worker *w = arg;
+    return scheduler_push(w->sched, w->id, path);
+}
+
+static bool scheduler_offer_dir(const char *path, struct ignore_list *ignore, void *arg) {
+    struct worker *w = arg;
+    return atomic_load(&w->sched->idle) > 0 && scheduler_add_dir(w->sched, path, ignore);
+}
+
+#ifdef __linux__
+/* parse_id_list()
+ * Adds the numbers of a sysfs list such as "0-3,8-11" to 'set'. Returns false if the list is
+ * malformed or names a number beyond CPU_SETSIZE.
+ */
+static bool parse_id_list(const char *s, cpu_set_t *set) {
+    while (*s && *s != '\n') {
+        char *end;
+        unsigned long lo = strtoul(s, &end, 10), hi = lo;
+        if (end == s)
+            return false;
+        if (*end == '-') {
+            s = end + 1;
+            hi = strtoul(s, &end, 10);
+            if (end == s)
+                return false;
+        }
+        if (hi >= CPU_SETSIZE || lo > hi)
+            return false;
+        for (unsigned long id = lo; id <= hi; id++)
+            CPU_SET(id, set);
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return true;
+}
+
+/* read_id_list()
+ * Reads the sysfs list in file 'path' into 'set'. Returns false if it cannot be read.
+ */
+static bool read_id_list(const char *path, cpu_set_t *set) {
+    char buf[4096];
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return false;
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return false;
+    buf[n] = '\0';
+    CPU_ZERO(set);
+    return parse_id_list(buf, set);
+}
+
+/* numa_load()
+ * Finds the online NUMA nodes that have CPUs this process may run on (which honours taskset
+ * and cgroup limits) and stores those CPUs, one set per node, in *nodes. Returns the number of
+ * nodes, or 0 (with *nodes NULL) on a machine with only one, where there is nothing to pin.
+ */
+static int numa_load(cpu_set_t **nodes) {
+    *nodes = NULL;
+    cpu_set_t online, allowed;
+    if (!read_id_list("/sys/devices/system/node/online", &online) || CPU_COUNT(&online) < 2 ||
+        sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return 0;
+    cpu_set_t *sets = malloc(CPU_COUNT(&online) * sizeof(cpu_set_t));
+    if (!sets)
+        return 0;
+    int count = 0;
+    for (int node = 0; node < CPU_SETSIZE; node++) {
+        char path[64];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        if (!CPU_ISSET(node, &online) || !read_id_list(path, &sets[count]))
+            continue;
+        CPU_AND(&sets[count], &sets[count], &allowed);
+        if (CPU_COUNT(&sets[count]) > 0)
+            count++;
+    }
+    if (count < 2) {
+        free(sets);
+        return 0;
+    }
+    *nodes = sets;
+    return count;
+}
+#endif
+
+#ifdef REFLOW_IO_URING
+static void *uring_map(int fd, size_t len, off_t offset) {
+    void *p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return p == MAP_FAILED ? NULL : p;
+}
+
+/* uring_free()
+ * Unmaps the rings and closes the ring's descriptor. Safe on a ring that failed to set up.
+ */
+static void uring_free(struct uring *r) {
+    if (r->sqes)
+        munmap(r->sqes, r->sqes_len);
+    if (r->cq_map && r->cq_map != r->sq_map)
+        munmap(r->cq_map, r->cq_len);
+    if (r->sq_map)
+        munmap(r->sq_map, r->sq_len);
+    if (r->fd >= 0)
+        close(r->fd);
+    memset(r, 0, sizeof(*r));
+    r->fd = -1;
+}
+
+/* uring_init()
+ * Creates a ring of 'entries' submission entries and maps it. Returns false (with r->fd -1)
+ * if that is not possible.
+ */
+static bool uring_init(struct uring *r, unsigned entries) {
+    memset(r, 0, sizeof(*r));
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    r->fd = (int)syscall(SYS_io_uring_setup, entries, &p);
+    if (r->fd < 0) {
+        r->fd = -1;
+        return false;
+    }
+    r->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && r->cq_len > r->sq_len)
+        r->sq_len = r->cq_len;
+    r->sq_map = uring_map(r->fd, r->sq_len, IORING_OFF_SQ_RING);
+    r->cq_map = single ? r->sq_map : uring_map(r->fd, r->cq_len, IORING_OFF_CQ_RING);
+    r->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    r->sqes = uring_map(r->fd, r->sqes_len, IORING_OFF_SQES);
+    if (!r->sq_map || !r->cq_map || !r->sqes) {
+        uring_free(r);
+        return false;
+    }
+    char *sq = r->sq_map, *cq = r->cq_map;
+    r->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    r->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    r->sq_array = (unsigned *)(sq + p.sq_off.array);
+    r->cq_head = (unsigned *)(cq + p.cq_off.head);
+    r->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    r->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    r->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return true;
+}
+
+/* uring_sqe()
+ * Returns the next submission entry, zeroed and tagged with 'user_data'. Callers never have
+ * more than URING_ENTRIES entries unsubmitted.
+ */
+static struct io_uring_sqe *uring_sqe(struct uring *r, uint8_t opcode, uint64_t user_data) {
+    unsigned index = (*r->sq_tail + r->unsubmitted++) & *r->sq_mask;
+    struct io_uring_sqe *sqe = &r->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->user_data = user_data;
+    r->sq_array[index] = index;
+    return sqe;
+}
+
+/* uring_failed()
+ * io_uring_enter() failed for a reason other than a signal or a momentary shortage, which
+ * means a bug here. Entries may still be in flight, writing into buffers that would be
+ * reused, so there is nothing safe to do but stop.
+ */
+static void uring_failed(void) {
+    perror("io_uring_enter");
+    abort();
+}
+
+static bool uring_retry(void) {
+    return errno == EINTR || errno == EAGAIN || errno == EBUSY;
+}
+
+/* uring_submit()
+ * Hands every entry filled in so far to the kernel in one io_uring_enter().
+ */
+static void uring_submit(struct uring *r) {
+    __atomic_store_n(r->sq_tail, *r->sq_tail + r->unsubmitted, __ATOMIC_RELEASE);
+    while (r->unsubmitted > 0) {
+        long n = syscall(SYS_io_uring_enter, r->fd, r->unsubmitted, 0, 0, NULL, 0);
+        if (n < 0 && !uring_retry())
+            uring_failed();
+        if (n > 0)
+            r->unsubmitted -= (unsigned)n;
+    }
+}
+
+/* uring_wait()
+ * Waits for the next completion and stores its tag and result.
+ */
+static void uring_wait(struct uring *r, uint64_t *user_data, int *res) {
+    unsigned head = *r->cq_head;
+    while (head == __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE)) {
+        long n = syscall(SYS_io_uring_enter, r->fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (n < 0 && !uring_retry())
+            uring_failed();
+    }
+    const struct io_uring_cqe *cqe = &r->cqes[head & *r->cq_mask];
+    *user_data = cqe->user_data;
+    *res = cqe->res;
+    __atomic_store_n(r->cq_head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* struct uring_file
+ * A file of a batch on its way through the ring.
+ */
+struct uring_file {
+    const char *path;
+    const struct changed_file *changed;
+    bool wanted;       /* still to be loaded and processed */
+    int fd;            /* -1 until opened */
+    int error;         /* errno of the first step that failed, 0 if none */
+    struct statx stx;
+    struct stat st;    /* the parts of 'stx' that process_loaded() looks at */
+    char *data;
+    size_t size, done; /* bytes expected and read */
+};
+
+/* uring_read()
+ * Queues a read of the rest of file 'i' of the batch.
+ */
+static void uring_read(struct uring *r, struct uring_file *f, size_t i) {
+    struct io_uring_sqe *sqe = uring_sqe(r, IORING_OP_READ, i);
+    sqe->fd = f->fd;
+    sqe->addr = (uintptr_t)(f->data + f->done);
+    sqe->len = (unsigned)(f->size - f->done);
+    sqe->off = f->done;
+}
+
+/* uring_fail()
+ * Reports file 'f' as failed with f->error and releases what it holds.
+ */
+static void uring_fail(struct uring_file *f, struct run_context *ctx) {
+    errno = f->error;
+    perror(f->path);
+    manifest_add(ctx->manifest, f->path, "failed", 0, NULL, 0);
+    if (f->fd >= 0)
+        close(f->fd);
+    free(f->data);
+    f->fd = -1;
+    f->data = NULL;
+    f->wanted = false;
+}
+
+/* uring_process()
+ * Indexes the bytes read for file 'f' and runs process_loaded() on them, which takes over the
+ * buffer and the descriptor.
+ */
+static int uring_process(struct worker *w, struct uring_file *f, struct run_stats *stats,
+                         FILE *log) {
+    struct run_context *ctx = w->sched->ctx;
+    struct source src;
+    memset(&src, 0, sizeof(src));
+    src.data = f->data;
+    src.size = f->done;
+    src.fd = f->fd;
+    src.width = ctx->rules.width;
+    f->wanted = false;
+    uint64_t t = stats ? now_ns() : 0;
+    if (scan_source(&src) != 0) {
+        perror("realloc");
+        free_source(&src);
+        manifest_add(ctx->manifest, f->path, "failed", 0, NULL, 0);
+        return -1;
+    }
+    if (stats)
+        stats->read_ns += now_ns() - t;
+    return process_loaded(f->path, ctx, &w->arena, stats, log, f->changed, &f->st, &src);
+}
+
+/* process_batch_uring()
+ * process_file() for a batch of small files, with their I/O going through the worker's ring:
+ * one submission opens and stats every file of the batch, a second reads all of them, and
+ * each file's rules run as soon as its read completes while the other reads are still in
+ * flight. Files the cache knows to be clean are closed unread. Returns -1 if some file could
+ * not be processed, 0 otherwise.
+ */
+static int process_batch_uring(struct worker *w, const struct queued_file *batch, size_t n,
+                               struct run_stats *stats, FILE *log) {
+    struct run_context *ctx = w->sched->ctx;
+    struct uring *r = &w->ring;
+    struct uring_file files[SCHED_BATCH_FILES];
+    int status = 0;
+    uint64_t t = stats ? now_ns() : 0;
+    size_t expected = 0;
+    for (size_t i = 0; i < n; i++) {
+        struct uring_file *f = &files[i];
+        *f = (struct uring_file){.path = batch[i].path, .fd = -1};
+        f->wanted = process_wants(f->path, ctx, &f->changed);
+        if (!f->wanted)
+            continue;
+        if (stats)
+            stats->files++;
+        struct io_uring_sqe *sqe = uring_sqe(r, IORING_OP_OPENAT, 2 * i);
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uintptr_t)f->path;
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        sqe = uring_sqe(r, IORING_OP_STATX, 2 * i + 1);
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uintptr_t)f->path;
+        sqe->len = STATX_BASIC_STATS;
+        sqe->off = (uintptr_t)&f->stx;
+        expected += 2;
+    }
+    uring_submit(r);
+    for (; expected > 0; expected--) {
+        uint64_t tag;
+        int res;
+        uring_wait(r, &tag, &res);
+        struct uring_file *f = &files[tag / 2];
+        if (res < 0 && f->error == 0)
+            f->error = -res;
+        else if (tag % 2 == 0 && res >= 0)
+            f->fd = res;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        struct uring_file *f = &files[i];
+        if (!f->wanted)
+            continue;
+        if (f->error == 0 && !S_ISREG(f->stx.stx_mode))
+            f->error = EINVAL;
+        if (f->error != 0) {
+            uring_fail(f, ctx);
+            status = -1;
+            continue;
+        }
+        f->st.st_mode = f->stx.stx_mode;
+        f->st.st_uid = f->stx.stx_uid;
+        f->st.st_gid = f->stx.stx_gid;
+        f->st.st_size = (off_t)f->stx.stx_size;
+        f->st.st_mtim.tv_sec = f->stx.stx_mtime.tv_sec;
+        f->st.st_mtim.tv_nsec = f->stx.stx_mtime.tv_nsec;
+        if (ctx->cache && cache_stat_matches(ctx->cache, f->path, &f->st)) {
+            close(f->fd);
+            f->wanted = false;
+            if (stats)
+                stats->cached++;
+            continue;
+        }
+        f->size = (size_t)f->stx.stx_size;
+        f->data = malloc(f->size ? f->size : 1);
+        if (!f->data) {
+            f->error = ENOMEM;
+            uring_fail(f, ctx);
+            status = -1;
+        } else if (f->size > 0) {
+            uring_read(r, f, i);
+            expected++;
+        }
+    }
+    uring_submit(r);
+    if (stats)
+        stats->read_ns += now_ns() - t;
+
+    // Empty files have nothing to wait for; the others are processed in the order they arrive.
+    for (size_t i = 0; i < n; i++)
+        if (files[i].wanted && files[i].size == 0 && uring_process(w, &files[i], stats, log) != 0)
+            status = -1;
+    while (expected > 0) {
+        uint64_t tag;
+        int res;
+        t = stats ? now_ns() : 0;
+        uring_wait(r, &tag, &res);
+        if (stats)
+            stats->read_ns += now_ns() - t;
+        expected--;
+        struct uring_file *f = &files[tag];
+        if (res < 0) {
+            f->error = -res;
+            uring_fail(f, ctx);
+            status = -1;
+            continue;
+        }
+        f->done += (size_t)res;
+        // A short read is continued; a file that shrank meanwhile is taken as it is now.
+        if (res > 0 && f->done < f->size) {
+            uring_read(r, f, tag);
+            uring_submit(r);
+            expected++;
+            continue;
+        }
+        if (uring_process(w, f, stats, log) != 0)
+            status = -1;
+    }
+    return status;
+}
+#endif
+
+/* worker_main()
+ * Runs the per-file pipeline on queued paths, and walks queued directories whenever there is
+ * no file to take. A worker assigned to a NUMA node first moves onto that node's CPUs, so the
+ * arena and the buffers it allocates afterwards are placed in the node's memory. The messages
+ * of a batch are buffered and written to stdout in one piece, so output from different files
+ * never interleaves.
+ */
+static void *worker_main(void *arg) {
+    struct worker *w = arg;
+    struct scheduler *sched = w->sched;
+#ifdef __linux__
+    // Not fatal: the worker just runs wherever the kernel puts it.
+    if (w->node >= 0)
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &sched->nodes[w->node]);
+#endif
+#ifdef REFLOW_IO_URING
+    uring_init(&w->ring, URING_ENTRIES);
+#endif
+    struct queued_file batch[SCHED_BATCH_FILES];
+    for (;;) {
+        size_t n = scheduler_next(sched, w->id, batch);
+        if (n == 0) {
+            bool done;
+            struct dir_task *task = scheduler_wait(sched, &done);
+            if (task) {
+                struct walker walker = {sched->ctx->walk, sched->root_len, visit_walked_file,
+                                        scheduler_offer_dir, NULL, w};
+                if (walk_subtree(&walker, task->path, task->ignore) != 0)
+                    w->status = -1;
+                scheduler_walked(sched, task);
+            } else if (done) {
+                break;
+            }
+            continue;
+        }
+        char *buf = NULL;
+        size_t len = 0;
+        FILE *log = open_memstream(&buf, &len);
+        if (!log)
+            perror("open_memstream");
+        struct run_stats *stats = sched->ctx->stats ? &w->stats : NULL;
+#ifdef REFLOW_IO_URING
+        // Large files are mapped as usual; batches of small ones share the ring.
+        if (log && w->ring.fd >= 0 && batch[0].size < SCHED_LARGE_MIN) {
+            if (process_batch_uring(w, batch, n, stats, log) != 0)
+                w->status = -1;
+            for (size_t i = 0; i < n; i++)
+                free(batch[i].path);
+            n = 0;
+        }
+#endif
+        for (size_t i = 0; i < n; i++) {
+            if (!log || process_file(batch[i].path, sched->ctx, &w->arena, stats, log) != 0)
+                w->status = -1;
+            free(batch[i].path);
+        }
+        if (!log)
+            continue;
+        fclose(log);
+        pthread_mutex_lock(&sched->output_lock);
+        fwrite(buf, 1, len, stdout);
+        fflush(stdout);
+        pthread_mutex_unlock(&sched->output_lock);
+        free(buf);
+    }
+#ifdef REFLOW_IO_URING
+    uring_free(&w->ring);
+#endif
+    arena_free(&w->arena);
+    return NULL;
+}
+
+/* process_directory_parallel()
+ * Walks the directory and processes its files with 'nworkers' threads, which share both the
+ * walk and the files it finds; with --since the changed files are queued up front instead.
+ * On a machine with several NUMA nodes, the workers are spread over the nodes round-robin.
+ * Returns -1 if the walk or any worker failed, 0 otherwise.
+ */
+int process_directory_parallel(const char *dir_path, struct run_context *ctx, int nworkers) {
+    struct scheduler sched = {0};
+    sched.nworkers = nworkers;
+    sched.ctx = ctx;
+    sched.root_len = strlen(dir_path);
+    pthread_mutex_init(&sched.output_lock, NULL);
+    pthread_mutex_init(&sched.walk_lock, NULL);
+    pthread_cond_init(&sched.work, NULL);
+    pthread_mutex_init(&sched.large.lock, NULL);
+#ifdef __linux__
+    sched.nnodes = numa_load(&sched.nodes);
+#endif
+    sched.deques = calloc(nworkers, sizeof(struct file_deque));
+    struct worker *workers = calloc(nworkers, sizeof(struct worker));
+    if (!sched.deques || !workers) {
+        perror("calloc");
+        free(sched.deques);
+        free(workers);
+#ifdef __linux__
+        free(sched.nodes);
+#endif
+        return -1;
+    }
+    for (int i = 0; i < nworkers; i++)
+        pthread_mutex_init(&sched.deques[i].lock, NULL);
+    int status = 0;
+    if (ctx->changes) {
+        status = walk_targets(dir_path, ctx, visit_queue_file, &sched);
+    } else if (!scheduler_add_dir(&sched, dir_path, NULL)) {
+        perror("malloc");
+        status = -1;
+    }
+    int started = 0;
+    for (int i = 0; i < nworkers; i++) {
+        workers[i].sched = &sched;
+        workers[i].id = i;
+        workers[i].node = -1;
+#ifdef __linux__
+        if (sched.nnodes > 0)
+            workers[i].node = i % sched.nnodes;
+#endif
+        if (pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]) != 0) {
+            perror("pthread_create");
+            status = -1;
+            break;
+        }
+        started++;
+    }
+    // Threads that did start steal the remaining work; with none at all, drain it here,
+    // without pinning the calling thread.
+    if (started == 0) {
+        workers[0].node = -1;
+        worker_main(&workers[0]);
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(workers[i].thread, NULL);
+    for (int i = 0; i < nworkers; i++) {
+        if (workers[i].status != 0)
+            status = -1;
+        if (ctx->stats)
+            stats_merge(ctx->stats, &workers[i].stats);
+        stats_free(&workers[i].stats);
+        free(sched.deques[i].files);
+        pthread_mutex_destroy(&sched.deques[i].lock);
+    }
+    free(sched.large.files);
+    pthread_mutex_destroy(&sched.large.lock);
+#ifdef __linux__
+    free(sched.nodes);
+#endif
+    pthread_mutex_destroy(&sched.output_lock);
+    pthread_mutex_destroy(&sched.walk_lock);
+    pthread_cond_destroy(&sched.work);
+    free(sched.deques);
+    free(workers);
+    return status;
+}
+
+// The library build (see reflow.h) leaves out the command-line front end.
+#ifndef REFLOW_NO_MAIN
+
+// ----------------- Daemon -----------------
+
+#define DAEMON_DEBOUNCE_MS 100   // quiet time after the last event before files are processed
+#define DAEMON_MAX_DELAY_MS 1000 // longest a change waits while events keep coming
+#define DAEMON_CLIENTS 16
+
+static volatile sig_atomic_t daemon_stopping;
+
+static void daemon_signal(int sig) {
+    (void)sig;
+    daemon_stopping = 1;
+}
+
+#ifdef __linux__
+
+#define WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | \
+                      IN_ONLYDIR)
+
+/* struct watch
+ * A watched directory and the ignore rules that apply inside it. 'gen' is the last rescan
+ * that found it, so watches on directories that are gone or now excluded can be dropped.
+ */
+struct watch {
+    char *path; /* NULL for a descriptor that is not in use */
+    struct ignore_list *ignore;
+    unsigned gen;
+};
+
+/* struct daemon_client
+ * A connection on the daemon's socket and the part of a request line read so far.
+ */
+struct daemon_client {
+    int fd; /* -1 for a free slot */
+    char buf[BUFFER_SIZE];
+    size_t len;
+};
+
+/* struct daemon
+ * State of --daemon: the watches (indexed by inotify watch descriptor), the debounced queue
+ * of files to process and the socket clients. 'rescan' asks for the whole tree to be walked
+ * again before the queue is processed.
+ */
+struct daemon {
+    struct run_context *ctx;
+    struct walker walker;
+    const char *root;
+    char *root_real; /* 'root' with symlinks resolved, to check request paths against */
+    int inotify_fd, listen_fd;
+    struct watch *watches;
+    size_t nwatches;
+    unsigned gen;
+    char **pending;
+    size_t npending, pending_capacity;
+    bool rescan;
+    uint64_t first_ns, due_ns; /* first event in the queue and when it is processed; 0 if none */
+    struct arena arena;
+    struct daemon_client clients[DAEMON_CLIENTS];
+};
+
+/* daemon_touch()
+ * Pushes the deadline of the queue back after an event, up to DAEMON_MAX_DELAY_MS after the
+ * first one.
+ */
+static void daemon_touch(struct daemon *d) {
+    uint64_t now = now_ns();
+    if (!d->first_ns)
+        d->first_ns = now;
+    d->due_ns = now + DAEMON_DEBOUNCE_MS * 1000000ull;
+    if (d->due_ns > d->first_ns + DAEMON_MAX_DELAY_MS * 1000000ull)
+        d->due_ns = d->first_ns + DAEMON_MAX_DELAY_MS * 1000000ull;
+}
+
+static int daemon_queue(const char *path, void *arg) {
+    struct daemon *d = arg;
+    if (d->npending == d->pending_capacity) {
+        size_t capacity = d->pending_capacity ? d->pending_capacity * 2 : 64;
+        char **tmp = realloc(d->pending, capacity * sizeof(char *));
+        if (!tmp) {
+            perror("realloc");
+            return -1;
+        }
+        d->pending = tmp;
+        d->pending_capacity = capacity;
+    }
+    char *copy = strdup(path);
+    if (!copy) {
+        perror("strdup");
+        return -1;
+    }
+    d->pending[d->npending++] = copy;
+    daemon_touch(d);
+    return 0;
+}
+
+static void watch_clear(struct watch *w) {
+    free(w->path);
+    ignore_unref(w->ignore);
+    memset(w, 0, sizeof(*w));
+}
+
+/* daemon_enter()
+ * Watches a directory the walk reached, or refreshes its path and ignore rules if it is
+ * watched already (inotify hands out one descriptor per directory).
+ */
+static int daemon_enter(const char *path, const struct ignore_list *ignore, void *arg) {
+    struct daemon *d = arg;
+    int wd = inotify_add_watch(d->inotify_fd, path, WATCH_EVENTS);
+    if (wd == -1) {
+        if (errno == ENOSPC)
+            fprintf(stderr, "Error: cannot watch %s: raise fs.inotify.max_user_watches.\n", path);
+        else
+            perror(path);
+        return -1;
+    }
+    if ((size_t)wd >= d->nwatches) {
+        size_t n = d->nwatches ? d->nwatches : 64;
+        while (n <= (size_t)wd)
+            n *= 2;
+        struct watch *tmp = realloc(d->watches, n * sizeof(*tmp));
+        if (!tmp) {
+            perror("realloc");
+            inotify_rm_watch(d->inotify_fd, wd);
+            return -1;
+        }
+        memset(tmp + d->nwatches, 0, (n - d->nwatches) * sizeof(*tmp));
+        d->watches = tmp;
+        d->nwatches = n;
+    }
+    struct watch *w = &d->watches[wd];
+    if (!w->path || strcmp(w->path, path) != 0) {
+        char *copy = strdup(path);
+        if (!copy) {
+            perror("strdup");
+            return -1;
+        }
+        free(w->path);
+        w->path = copy;
+    }
+    struct ignore_list *old = w->ignore;
+    w->ignore = ignore_ref((struct ignore_list *)ignore);
+    ignore_unref(old);
+    w->gen = d->gen;
+    return 0;
+}
+
+/* daemon_rescan()
+ * Walks the whole tree again: every directory is watched, every file is queued (the cache
+ * keeps this cheap for files already seen), and watches the walk did not reach are dropped.
+ */
+static void daemon_rescan(struct daemon *d) {
+    d->rescan = false;
+    d->gen++;
+    walk_subtree(&d->walker, d->root, NULL);
+    for (size_t i = 0; i < d->nwatches; i++) {
+        if (d->watches[i].path && d->watches[i].gen != d->gen) {
+            inotify_rm_watch(d->inotify_fd, (int)i);
+            watch_clear(&d->watches[i]);
+        }
+    }
+}
+
+/* daemon_process()
+ * Processes one file, writing its messages to 'log'. A file rewritten here is recorded in the
+ * cache as it is now, so the events caused by rewriting it do not get it processed again.
+ * Files deleted since they were queued are skipped.
+ */
+static int daemon_process(struct daemon *d, const char *path, FILE *log) {
+    struct stat before, after;
+    if (stat(path, &before) == -1) {
+        if (errno == ENOENT)
+            return 0;
+        perror(path);
+        return -1;
+    }
+    if (process_file(path, d->ctx, &d->arena, d->ctx->stats, log) != 0)
+        return -1;
+    if (stat(path, &after) == -1 || (after.st_ino == before.st_ino &&
+                                     after.st_mtim.tv_sec == before.st_mtim.tv_sec &&
+                                     after.st_mtim.tv_nsec == before.st_mtim.tv_nsec))
+        return 0;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return 0;
+    size_t size;
+    char *data = (fstat(fd, &after) == 0) ? read_fd_contents(fd, &size) : NULL;
+    if (data)
+        cache_mark_clean(d->ctx->cache, path, &after, xxh64(data, size, 0));
+    free(data);
+    close(fd);
+    return 0;
+}
+
+static int compare_paths(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* daemon_flush()
+ * Rescans the tree if that was asked for, then processes every queued file once.
+ */
+static void daemon_flush(struct daemon *d) {
+    if (d->rescan)
+        daemon_rescan(d);
+    if (d->npending > 1)
+        qsort(d->pending, d->npending, sizeof(char *), compare_paths);
+    for (size_t i = 0; i < d->npending; i++) {
+        if (i == 0 || strcmp(d->pending[i], d->pending[i-1]) != 0)
+            daemon_process(d, d->pending[i], stdout);
+    }
+    for (size_t i = 0; i < d->npending; i++)
+        free(d->pending[i]);
+    d->npending = 0;
+    d->first_ns = d->due_ns = 0;
+    fflush(stdout);
+}
+
+/* daemon_event()
+ * Queues the file an inotify event is about. Anything that changes which directories and
+ * rules make up the tree (directories coming or going, an edited .gitignore, lost events)
+ * asks for a rescan instead. Returns false once the root directory itself is gone.
+ */
+static bool daemon_event(struct daemon *d, const struct inotify_event *ev) {
+    if (ev->mask & IN_Q_OVERFLOW) {
+        d->rescan = true;
+        daemon_touch(d);
+        return true;
+    }
+    if (ev->wd < 0 || (size_t)ev->wd >= d->nwatches || !d->watches[ev->wd].path)
+        return true;
+    struct watch *w = &d->watches[ev->wd];
+    if (ev->mask & IN_IGNORED) {
+        bool root = (strcmp(w->path, d->root) == 0);
+        watch_clear(w);
+        return !root;
+    }
+    if (ev->len == 0 || strlen(ev->name) > NAME_MAX)
+        return true;
+    if ((ev->mask & IN_ISDIR) || (strcmp(ev->name, ".gitignore") == 0 && !d->walker.opts->no_ignore)) {
+        d->rescan = true;
+        daemon_touch(d);
+        return true;
+    }
+    if (!(ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) || !is_python_file(ev->name))
+        return true;
+    char path[BUFFER_SIZE + NAME_MAX + 2];
+    snprintf(path, sizeof(path), "%s/%s", w->path, ev->name);
+    if (!walk_skips(&d->walker, path, ev->name, false, w->ignore))
+        daemon_queue(path, d);
+    return true;
+}
+
+/* daemon_read_events()
+ * Handles every inotify event that is ready. Returns false once the root directory is gone.
+ */
+static bool daemon_read_events(struct daemon *d) {
+    _Alignas(struct inotify_event) char buf[16 * 1024];
+    for (;;) {
+        ssize_t n = read(d->inotify_fd, buf, sizeof(buf));
+        if (n <= 0)
+            return true;
+        for (ssize_t off = 0; off < n; ) {
+            const struct inotify_event *ev = (const struct inotify_event *)(buf + off);
+            if (!daemon_event(d, ev))
+                return false;
+            off += sizeof(*ev) + ev->len;
+        }
+    }
+}
+
+/* write_all()
+ * Writes all n bytes of buf to fd, retrying short writes. Returns false on error.
+ */
+static bool write_all(int fd, const char *buf, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, buf, n);
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buf += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+/* daemon_tree_path()
+ * Maps a path sent by a client to the name the walk gives that file, provided the walk would
+ * process it: a regular ".py" file that resolves to a place under the root, in a directory the
+ * walk reached, and not excluded or ignored. Returns the name (malloc'ed), or NULL with 'why'
+ * set to the reason the file is refused.
+ */
+static char *daemon_tree_path(struct daemon *d, const char *request, const char **why) {
+    char *real = realpath(request, NULL);
+    if (!real) {
+        *why = strerror(errno);
+        return NULL;
+    }
+    size_t root_len = strcmp(d->root_real, "/") == 0 ? 0 : strlen(d->root_real);
+    const char *rel = real + root_len;
+    struct stat st;
+    char *path = NULL;
+    if (strncmp(real, d->root_real, root_len) != 0 || rel[0] != '/')
+        *why = "outside the watched tree";
+    else if (stat(real, &st) == -1)
+        *why = strerror(errno);
+    else if (!S_ISREG(st.st_mode) || !is_python_file(rel))
+        *why = "not a .py file";
+    else if (!(path = malloc(strlen(d->root) + strlen(rel) + 1)))
+        *why = strerror(errno);
+    if (!path) {
+        free(real);
+        return NULL;
+    }
+    sprintf(path, "%s%s", d->root, rel);
+    free(real);
+    // Directories the walk reached are exactly the watched ones, each with its ignore rules.
+    if (d->rescan)
+        daemon_rescan(d);
+    const char *name = strrchr(path, '/') + 1;
+    size_t dir_len = (size_t)(name - 1 - path);
+    const struct watch *w = NULL;
+    for (size_t i = 0; i < d->nwatches && !w; i++) {
+        const char *wp = d->watches[i].path;
+        if (wp && strlen(wp) == dir_len && strncmp(wp, path, dir_len) == 0)
+            w = &d->watches[i];
+    }
+    if (!w || walk_skips(&d->walker, path, name, false, w->ignore)) {
+        *why = "excluded or ignored by the walk";
+        free(path);
+        return NULL;
+    }
+    return path;
+}
+
+/* daemon_request()
+ * Answers one request line from a client:
+ *   FORMAT <path>   processes the file now; replies with its messages, then "OK" or "ERROR"
+ *   PING            replies "OK"
+ * Relative paths are taken from the daemon's working directory. Only files the walk of the
+ * tree would process are accepted (see daemon_tree_path()); others get "ERROR <path>: <why>".
+ * Returns false if the reply could not be sent.
+ */
+static bool daemon_request(struct daemon *d, struct daemon_client *c, char *line) {
+    strip_crlf(line);
+    if (strcmp(line, "PING") == 0)
+        return write_all(c->fd, "OK\n", 3);
+    if (strncmp(line, "FORMAT ", 7) != 0 || !line[7]) {
+        static const char reply[] = "ERROR unknown request\n";
+        return write_all(c->fd, reply, sizeof(reply) - 1);
+    }
+    const char *why;
+    char *path = daemon_tree_path(d, line + 7, &why);
+    if (!path) {
+        char reply[BUFFER_SIZE + 64];
+        int n = snprintf(reply, sizeof(reply), "ERROR %s: %s\n", line + 7, why);
+        return write_all(c->fd, reply, (size_t)n < sizeof(reply) ? (size_t)n : sizeof(reply) - 1);
+    }
+    char *messages = NULL;
+    size_t len = 0;
+    FILE *log = open_memstream(&messages, &len);
+    if (!log) {
+        free(path);
+        return write_all(c->fd, "ERROR\n", 6);
+    }
+    int status = daemon_process(d, path, log);
+    free(path);
+    fputs(status == 0 ? "OK\n" : "ERROR\n", log);
+    bool ok = fclose(log) == 0 && write_all(c->fd, messages, len);
+    free(messages);
+    return ok;
+}
+
+static void client_close(struct daemon_client *c) {
+    close(c->fd);
+    c->fd = -1;
+    c->len = 0;
+}
+
+/* client_read()
+ * Reads from a client and answers the complete request lines. The connection is closed at
+ * end of input, on errors, and when a line does not fit the buffer.
+ */
+static void client_read(struct daemon *d, struct daemon_client *c) {
+    ssize_t n = read(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len);
+    if (n <= 0) {
+        if (n < 0 && errno == EINTR)
+            return;
+        client_close(c);
+        return;
+    }
+    c->len += (size_t)n;
+    c->buf[c->len] = '\0';
+    char *line = c->buf, *nl;
+    while ((nl = strchr(line, '\n')) != NULL) {
+        *nl = '\0';
+        if (!daemon_request(d, c, line)) {
+            client_close(c);
+            return;
+        }
+        line = nl + 1;
+    }
+    c->len -= (size_t)(line - c->buf);
+    memmove(c->buf, line, c->len);
+    if (c->len == sizeof(c->buf) - 1)
+        client_close(c);
+}
+
+static void client_accept(struct daemon *d) {
+    int fd = accept4(d->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd == -1)
+        return;
+    for (int i = 0; i < DAEMON_CLIENTS; i++) {
+        if (d->clients[i].fd == -1) {
+            // A client that stops reading must not stall the daemon.
+            struct timeval timeout = {1, 0};
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            d->clients[i].fd = fd;
+            d->clients[i].len = 0;
+            return;
+        }
+    }
+    close(fd);
+}
+
+/* daemon_listen()
+ * Binds the request socket at 'path', readable and writable by the owner only. A socket file
+ * left behind by a daemon that is no longer running is replaced. Returns the listening
+ * descriptor, or -1 on error.
+ */
+static int daemon_listen(const char *path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Error: socket path '%s' is too long.\n", path);
+        return -1;
+    }
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        perror("socket");
+        return -1;
+    }
+    mode_t mask = umask(0177); // bind() creates the socket file with the umask applied.
+    int rc = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    if (rc == -1 && errno == EADDRINUSE) {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool live = probe != -1 && connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        if (probe != -1)
+            close(probe);
+        if (live) {
+            fprintf(stderr, "Error: a daemon is already listening on %s.\n", path);
+            umask(mask);
+            close(fd);
+            return -1;
+        }
+        unlink(path);
+        rc = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    }
+    umask(mask);
+    if (rc == -1 || listen(fd, DAEMON_CLIENTS) == -1) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+#endif /* __linux__ */
+
+/* run_daemon()
+ * Processes the tree under 'root' and then keeps watching it: files that are written or moved
+ * in are queued and processed once events have been quiet for DAEMON_DEBOUNCE_MS. Requests on
+ * the Unix socket at 'socket_path' are answered in between. ctx->cache must be set. Runs
+ * until SIGINT or SIGTERM, or until 'root' is removed. Returns 0 on a normal exit.
+ */
+int run_daemon(const char *root, const char *socket_path, struct run_context *ctx) {
+#ifdef __linux__
+    struct daemon d = {.ctx = ctx, .root = root, .rescan = true};
+    d.walker = (struct walker){ctx->walk, strlen(root), daemon_queue, NULL, daemon_enter, &d};
+    for (int i = 0; i < DAEMON_CLIENTS; i++)
+        d.clients[i].fd = -1;
+    d.root_real = realpath(root, NULL);
+    if (!d.root_real) {
+        perror(root);
+        return -1;
+    }
+    d.inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (d.inotify_fd == -1) {
+        perror("inotify_init1");
+        free(d.root_real);
+        return -1;
+    }
+    d.listen_fd = daemon_listen(socket_path);
+    if (d.listen_fd == -1) {
+        close(d.inotify_fd);
+        free(d.root_real);
+        return -1;
+    }
+    struct sigaction sa = {.sa_handler = daemon_signal};
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    fprintf(stderr, "Watching %s; requests on %s.\n", root, socket_path);
+    int status = 0;
+    daemon_flush(&d);
+    while (!daemon_stopping) {
+        struct pollfd fds[2 + DAEMON_CLIENTS];
+        int nfds = 0;
+        fds[nfds++] = (struct pollfd){.fd = d.inotify_fd, .events = POLLIN};
+        fds[nfds++] = (struct pollfd){.fd = d.listen_fd, .events = POLLIN};
+        for (int i = 0; i < DAEMON_CLIENTS; i++)
+            fds[nfds++] = (struct pollfd){.fd = d.clients[i].fd, .events = POLLIN};
+        int timeout = -1;
+        if (d.due_ns) {
+            uint64_t now = now_ns();
+            timeout = (d.due_ns > now) ? (int)((d.due_ns - now + 999999) / 1000000) : 0;
+        }
+        if (poll(fds, nfds, timeout) == -1) {
+            if (errno == EINTR)
+                continue;
+            perror("poll");
+            status = -1;
+            break;
+        }
+        if ((fds[0].revents & POLLIN) && !daemon_read_events(&d)) {
+            fprintf(stderr, "Error: %s was removed.\n", root);
+            status = -1;
+            break;
+        }
+        if (fds[1].revents & POLLIN)
+            client_accept(&d);
+        for (int i = 0; i < DAEMON_CLIENTS; i++)
+            if (d.clients[i].fd != -1 && fds[2 + i].revents)
+                client_read(&d, &d.clients[i]);
+        if (d.due_ns && now_ns() >= d.due_ns)
+            daemon_flush(&d);
+    }
+    for (int i = 0; i < DAEMON_CLIENTS; i++)
+        if (d.clients[i].fd != -1)
+            client_close(&d.clients[i]);
+    close(d.listen_fd);
+    unlink(socket_path);
+    close(d.inotify_fd);
+    for (size_t i = 0; i < d.nwatches; i++)
+        if (d.watches[i].path)
+            watch_clear(&d.watches[i]);
+    free(d.watches);
+    for (size_t i = 0; i < d.npending; i++)
+        free(d.pending[i]);
+    free(d.pending);
+    free(d.root_real);
+    arena_free(&d.arena);
+    return status;
+#else
+    (void)root; (void)socket_path; (void)ctx;
+    fprintf(stderr, "Error: --daemon needs inotify, which this platform does not provide.\n");
+    return -1;
+#endif
+}
+
+// ----------------- Sharding -----------------
+
+#define MANIFEST_VERSION 2
+#define SHARD_MAX 1024
+
+static const char *const mode_names[] = {"write", "check", "diff", "verify"};
+
+/* parse_shard()
+ * Parses the --shard argument "I/N" (1 <= I <= N <= SHARD_MAX) into shard I - 1 of N.
+ * Returns false (after printing an error) if it is not of that form.
+ */
+static bool parse_shard(const char *arg, struct shard *shard) {
+    char *end;
+    long i = strtol(arg, &end, 10);
+    long n = (*end == '/') ? strtol(end + 1, &end, 10) : 0;
+    if (*end || i < 1 || n < i || n > SHARD_MAX) {
+        fprintf(stderr, "Error: invalid shard '%s' (use I/N with 1 <= I <= N <= %d).\n", arg,
+                SHARD_MAX);
+        return false;
+    }
+    shard->index = (unsigned)(i - 1);
+    shard->count = (unsigned)n;
+    return true;
+}
+
+/* struct shard_listing
+ * Every file of the run with its size, as collected by shard_plan().
+ */
+struct shard_file {
+    char *path; /* below the target */
+    uint64_t size;
+};
+
+struct shard_listing {
+    struct shard_file *files;
+    size_t count, capacity;
+    size_t root_len;
+};
+
+static int shard_collect(const char *path, void *arg) {
+    struct shard_listing *l = arg;
+    struct stat st;
+    if (stat(path, &st) == -1) {
+        perror(path);
+        return -1;
+    }
+    if (l->count == l->capacity) {
+        size_t capacity = l->capacity ? l->capacity * 2 : 1024;
+        struct shard_file *tmp = realloc(l->files, capacity * sizeof(*tmp));
+        if (!tmp) {
+            perror("realloc");
+            return -1;
+        }
+        l->files = tmp;
+        l->capacity = capacity;
+    }
+    char *rel = strdup(relative_path(path, l->root_len));
+    if (!rel) {
+        perror("strdup");
+        return -1;
+    }
+    l->files[l->count++] = (struct shard_file){rel, (uint64_t)st.st_size};
+    return 0;
+}
+
+// Largest first; equal sizes by path, so that every node sorts alike.
+static int compare_shard_files(const void *a, const void *b) {
+    const struct shard_file *x = a, *y = b;
+    if (x->size != y->size)
+        return (x->size < y->size) - (x->size > y->size);
+    return strcmp(x->path, y->path);
+}
+
+/* shard_plan()
+ * For --shard-by=size: lists every file the run would process under 'target' (with their
+ * sizes from stat()), hands them out largest first, each to the shard with the fewest bytes so
+ * far (the lowest-numbered one on a tie), and keeps the paths of this node's shard. Every node
+ * computes the same assignment from the same tree. Returns 0, or -1 if the tree could not be
+ * listed.
+ */
+static int shard_plan(struct shard *shard, const char *target, struct run_context *ctx,
+                      bool is_dir) {
+    struct shard_listing l = {.root_len = shard->root_len};
+    int status = is_dir ? walk_targets(target, ctx, shard_collect, &l) : shard_collect(target, &l);
+    uint64_t *load = calloc(shard->count, sizeof(uint64_t));
+    shard->paths = malloc((l.count ? l.count : 1) * sizeof(char *));
+    if (!load || !shard->paths) {
+        perror("malloc");
+        status = -1;
+    }
+    if (status == 0) {
+        qsort(l.files, l.count, sizeof(*l.files), compare_shard_files);
+        for (size_t i = 0; i < l.count; i++) {
+            unsigned best = 0;
+            for (unsigned b = 1; b < shard->count; b++)
+                if (load[b] < load[best])
+                    best = b;
+            // Every file costs something, even an empty one.
+            load[best] += l.files[i].size + 1;
+            if (best == shard->index) {
+                shard->paths[shard->npaths++] = l.files[i].path;
+                l.files[i].path = NULL;
+            }
+        }
+        qsort(shard->paths, shard->npaths, sizeof(char *), compare_strings);
+    }
+    for (size_t i = 0; i < l.count; i++)
+        free(l.files[i].path);
+    free(l.files);
+    free(load);
+    return status;
+}
+
+static void shard_free(struct shard *shard) {
+    for (size_t i = 0; i < shard->npaths; i++)
+        free(shard->paths[i]);
+    free(shard->paths);
+}
+
+/* manifest_open()
+ * Creates the --emit-manifest file 'filename', JSON Lines: a header naming the shard, the
+ * output mode, the run's settings and the directory the paths are below (the first 'root_len'
+ * bytes of 'target'), then the records of manifest_add(), then the footer written by
+ * manifest_close(). Returns false (after printing an error) if the file cannot be created.
+ */
+static bool manifest_open(struct manifest *m, const char *filename, const struct shard *shard,
+                          enum output_mode mode, const char *settings, const char *target,
+                          size_t root_len) {
+    m->out = fopen(filename, "w");
+    if (!m->out) {
         perror(filename);
-        return;
+        return false;
     }
-    char **lines = NULL;
-    size_t count = 0, capacity = 0;
-    char buf[BUFFER_SIZE];
-    while (fgets(buf, sizeof(buf), fin)) {
-        if (count >= capacity) {
-            capacity = (capacity == 0) ? 256 : capacity * 2;
-            char **tmp = realloc(lines, capacity * sizeof(char *));
-            if (!tmp) {
-                perror("realloc");
-                fclose(fin);
-                return;
+    pthread_mutex_init(&m->lock, NULL);
+    m->root_len = root_len;
+    fprintf(m->out, "{\"manifest\":%d,\"shard\":%u,\"shards\":%u,\"by\":\"%s\",\"mode\":\"%s\","
+                    "\"settings\":", MANIFEST_VERSION, shard ? shard->index + 1 : 1,
+            shard ? shard->count : 1, shard && shard->by_size ? "size" : "hash", mode_names[mode]);
+    json_write_string(m->out, settings, strlen(settings));
+    fputs(",\"target\":", m->out);
+    json_write_string(m->out, target, root_len);
+    fputs("}\n", m->out);
+    return true;
+}
+
+/* manifest_close()
+ * Writes the footer, with the exit status, the file counts of the run, the time each
+ * --verify-idempotent pass took, every Black latency sample and the --stats=json report
+ * (everything --merge-results needs to add the shards up), and closes the file.
+ * Returns false (after printing an error) if it could not be written.
+ */
+static bool manifest_close(struct manifest *m, const char *filename, struct run_context *ctx,
+                           struct run_stats *stats, uint64_t wall_ns, int status) {
+    char *report = NULL;
+    size_t report_len = 0;
+    FILE *mem = open_memstream(&report, &report_len);
+    if (mem) {
+        stats_report(mem, stats, wall_ns, true);
+        fclose(mem);
+    }
+    while (report_len > 0 && report[report_len - 1] == '\n')
+        report_len--;
+    fprintf(m->out, "{\"status\":%d,\"would_change\":%zu,\"verified\":%zu,\"pass_ns\":[%llu,%llu],"
+                    "\"black_latency_ns\":[", status, atomic_load(&ctx->would_change),
+            atomic_load(&ctx->verified), (unsigned long long)atomic_load(&ctx->pass_ns[0]),
+            (unsigned long long)atomic_load(&ctx->pass_ns[1]));
+    for (size_t i = 0; i < stats->black_calls; i++)
+        fprintf(m->out, "%s%llu", i ? "," : "", (unsigned long long)stats->black_latency[i]);
+    fprintf(m->out, "],\"stats\":%.*s}\n", (int)report_len, report ? report : "{}");
+    free(report);
+    bool ok = !ferror(m->out);
+    if (fclose(m->out) != 0)
+        ok = false;
+    if (!ok)
+        perror(filename);
+    pthread_mutex_destroy(&m->lock);
+    return ok;
+}
+
+/* json_field()
+ * Finds "key": in the JSON text p and returns where its value starts, or NULL. Quotes inside
+ * string values are escaped, so this never matches inside one. Only for the manifests written
+ * above, whose keys are distinct where they are looked up.
+ */
+static const char *json_field(const char *p, const char *key) {
+    char needle[64];
+    snprintf(needle, sizeof(needle), "\"%s\":", key);
+    const char *f = p ? strstr(p, needle) : NULL;
+    return f ? f + strlen(needle) : NULL;
+}
+
+static uint64_t json_u64(const char *p, const char *key) {
+    const char *f = json_field(p, key);
+    return f ? strtoull(f, NULL, 10) : 0;
+}
+
+/* json_string()
+ * Decodes the JSON string value of 'key' in p into 'out' (as written by json_write_string()).
+ * Returns false if there is no such string or memory ran out.
+ */
+static bool json_string(const char *p, const char *key, struct strbuf *out) {
+    const char *f = json_field(p, key);
+    if (!f || *f != '"')
+        return false;
+    out->len = 0;
+    if (!strbuf_reserve(out, 0))
+        return false;
+    out->data[0] = '\0';
+    for (f++; *f && *f != '"'; f++) {
+        char c = *f;
+        if (c == '\\' && f[1]) {
+            c = *++f;
+            if (c == 'n')
+                c = '\n';
+            else if (c == 'u' && isxdigit((unsigned char)f[1]) && isxdigit((unsigned char)f[2]) &&
+                     isxdigit((unsigned char)f[3]) && isxdigit((unsigned char)f[4])) {
+                char hex[5] = {f[1], f[2], f[3], f[4], '\0'};
+                c = (char)strtol(hex, NULL, 16);
+                f += 4;
             }
-            lines = tmp;
         }
-        lines[count] = strdup(buf);
-        if (!lines[count]) {
-            perror("strdup");
-            fclose(fin);
-            return;
+        if (!strbuf_append(out, &c, 1))
+            return false;
+    }
+    return *f == '"';
+}
+
+/* stats_parse()
+ * Adds the counters of a --stats=json report to 'stats' (the latency samples come separately).
+ */
+static void stats_parse(const char *json, struct run_stats *stats) {
+    stats->files += json_u64(json, "files");
+    stats->changed += json_u64(json, "changed");
+    stats->cached += json_u64(json, "cached");
+    stats->bytes += json_u64(json, "bytes");
+    stats->lines += json_u64(json, "lines");
+    const char *stages = json_field(json, "stages_ns");
+    stats->read_ns += json_u64(stages, "read");
+    stats->rules_ns += json_u64(stages, "rules");
+    stats->black_ns += json_u64(stages, "black");
+    stats->write_ns += json_u64(stages, "write");
+    stats->rename_ns += json_u64(stages, "rename");
+    const char *rules = strstr(json, "\"rules\":{");
+    for (int r = RULE_A; r <= RULE_D; r++) {
+        char key[2] = {(char)('A' + r), '\0'};
+        const char *rule = json_field(rules, key);
+        stats->rules.tried[r] += json_u64(rule, "tried");
+        stats->rules.applied[r] += json_u64(rule, "applied");
+        stats->rules.ns[r] += json_u64(rule, "ns");
+    }
+    stats->black_snippets += json_u64(json, "snippets");
+    stats->memo_hits += json_u64(json, "memo_hits");
+}
+
+/* struct merged_file
+ * A file record of one of the manifests --merge-results reads.
+ */
+struct merged_file {
+    char *path, *result, *diff;
+    int changes;
+};
+
+static int compare_merged_files(const void *a, const void *b) {
+    return strcmp(((const struct merged_file *)a)->path, ((const struct merged_file *)b)->path);
+}
+
+/* struct merge
+ * What --merge-results has gathered so far from the manifests.
+ */
+struct merge {
+    char *settings, *mode, *by;
+    char *target;     /* of the first manifest; record paths are printed below it */
+    unsigned shards;
+    bool *seen;       /* per shard */
+    struct merged_file *files;
+    size_t nfiles, capacity;
+    struct run_stats stats;
+    uint64_t wall_ns, pass_ns[2];
+    size_t would_change, verified;
+    int status;
+};
+
+/* merge_header()
+ * Checks the header of manifest 'name' against the ones read before it.
+ */
+static bool merge_header(struct merge *mg, const char *name, const char *line) {
+    struct strbuf settings = {0}, mode = {0}, by = {0}, target = {0};
+    bool ok = false;
+    uint64_t shard = json_u64(line, "shard"), shards = json_u64(line, "shards");
+    if (json_u64(line, "manifest") != MANIFEST_VERSION || !json_string(line, "settings", &settings) ||
+        !json_string(line, "mode", &mode) || !json_string(line, "by", &by) ||
+        !json_string(line, "target", &target) || shard < 1 || shard > shards ||
+        shards > SHARD_MAX) {
+        fprintf(stderr, "Error: %s is not a manifest written by this version.\n", name);
+    } else if (!mg->seen) {
+        mg->shards = (unsigned)shards;
+        mg->seen = calloc(shards, sizeof(bool));
+        mg->settings = settings.data;
+        mg->mode = mode.data;
+        mg->by = by.data;
+        mg->target = target.data;
+        settings.data = mode.data = by.data = target.data = NULL;
+        ok = mg->seen != NULL;
+        if (!ok)
+            perror("calloc");
+    } else if (shards != mg->shards || strcmp(by.data, mg->by) != 0) {
+        fprintf(stderr, "Error: %s is shard %llu/%llu by %s, the others are of %u by %s.\n", name,
+                (unsigned long long)shard, (unsigned long long)shards, by.data, mg->shards, mg->by);
+    } else if (strcmp(settings.data, mg->settings) != 0 || strcmp(mode.data, mg->mode) != 0) {
+        fprintf(stderr, "Error: %s was made with other settings or another mode than the others.\n",
+                name);
+    } else {
+        ok = true;
+    }
+    if (ok && mg->seen[shard - 1]) {
+        fprintf(stderr, "Error: shard %llu/%u is given twice (again in %s).\n",
+                (unsigned long long)shard, mg->shards, name);
+        ok = false;
+    }
+    if (ok)
+        mg->seen[shard - 1] = true;
+    strbuf_free(&settings);
+    strbuf_free(&mode);
+    strbuf_free(&by);
+    strbuf_free(&target);
+    return ok;
+}
+
+/* merge_record()
+ * Adds a file record to the merge. Returns false if memory ran out or the record is broken.
+ */
+static bool merge_record(struct merge *mg, const char *name, const char *line) {
+    struct strbuf path = {0}, result = {0}, diff = {0};
+    if (!json_string(line, "path", &path) || !json_string(line, "result", &result)) {
+        fprintf(stderr, "Error: broken record in %s.\n", name);
+        strbuf_free(&path);
+        strbuf_free(&result);
+        return false;
+    }
+    json_string(line, "diff", &diff);
+    // Joined the way the walk joins a directory and an entry, so paths read as in one run.
+    size_t n = strlen(mg->target) + path.len + 2;
+    char *full = malloc(n);
+    if (full)
+        snprintf(full, n, "%s%s%s", mg->target, mg->target[0] ? "/" : "", path.data);
+    strbuf_free(&path);
+    if (!full) {
+        perror("malloc");
+        strbuf_free(&result);
+        strbuf_free(&diff);
+        return false;
+    }
+    if (mg->nfiles == mg->capacity) {
+        size_t capacity = mg->capacity ? mg->capacity * 2 : 256;
+        struct merged_file *tmp = realloc(mg->files, capacity * sizeof(*tmp));
+        if (!tmp) {
+            perror("realloc");
+            free(full);
+            strbuf_free(&result);
+            strbuf_free(&diff);
+            return false;
         }
-        count++;
+        mg->files = tmp;
+        mg->capacity = capacity;
     }
-    fclose(fin);
+    mg->files[mg->nfiles++] = (struct merged_file){full, result.data, diff.data,
+                                                   (int)json_u64(line, "changes")};
+    return true;
+}
 
-    char tmp_out[] = "/tmp/reflow_outputXXXXXX";
-    int fd_out = mkstemp(tmp_out);
-    if (fd_out == -1) {
-        perror("mkstemp output");
-        return;
+/* merge_footer()
+ * Adds the exit status, counts, pass times, latency samples and stats of a manifest's footer.
+ */
+static void merge_footer(struct merge *mg, const char *line) {
+    const char *stats = json_field(line, "stats");
+    if ((int)json_u64(line, "status") != 0)
+        mg->status = 1;
+    mg->would_change += json_u64(line, "would_change");
+    mg->verified += json_u64(line, "verified");
+    const char *pass = json_field(line, "pass_ns");
+    if (pass && *pass == '[') {
+        char *end;
+        mg->pass_ns[0] += strtoull(pass + 1, &end, 10);
+        if (*end == ',')
+            mg->pass_ns[1] += strtoull(end + 1, NULL, 10);
     }
-    FILE *fout = fdopen(fd_out, "w");
-    if (!fout) {
-        perror("fdopen output");
-        close(fd_out);
-        return;
+    const char *lat = json_field(line, "black_latency_ns");
+    if (lat && *lat == '[') {
+        const char *p = lat + 1;
+        while (isdigit((unsigned char)*p)) {
+            char *end;
+            stats_add_sample(&mg->stats, strtoull(p, &end, 10));
+            p = (*end == ',') ? end + 1 : end;
+        }
     }
+    uint64_t wall = json_u64(stats, "wall_ns");
+    if (wall > mg->wall_ns)
+        mg->wall_ns = wall;
+    stats_parse(stats, &mg->stats);
+}
 
-    int changes = 0;
-    for (size_t i = 0; i < count; i++) {
-        char *new_line = NULL;
-        // Rule D: Process existing triple-quoted blocks.
-        const char *trimmed = lines[i];
-        while (*trimmed && isspace((unsigned char)*trimmed))
-            trimmed++;
-        if (strncmp(trimmed, "\"\"\"", 3) == 0) {
-            size_t end_index;
-            new_line = process_triple_quote_block(lines, i, count, &end_index);
-            if (new_line) {
-                printf("Processed triple-quoted block in %s (lines %zu-%zu).\n", filename, i+1, end_index);
-                fputs(new_line, fout);
-                free(new_line);
-                changes++;
-                i = end_index - 1;
-                continue;
+/* merge_results()
+ * Implements --merge-results: reads the manifests of every shard of a run (see
+ * manifest_open()), checks that each shard is there once and that all of them were made with
+ * the same settings, and reports them as one run would have: each file's summary line (or
+ * diff) in path order on stdout, with the path below the first manifest's target as the run
+ * would print it, then the summary and, with 'want_stats', the combined statistics on stderr.
+ * The per-block messages of the write and verify modes are not recorded, so they are missing. The wall time is that of the slowest shard. Returns the exit status the single run
+ * would have had: 1 if a shard failed, is missing or incomplete, or if files would change.
+ */
+static int merge_results(char *const *names, int count, bool want_stats, bool stats_json) {
+    struct merge mg = {0};
+    int status = 0;
+    char *line = NULL;
+    size_t cap = 0;
+    for (int i = 0; i < count && status == 0; i++) {
+        FILE *in = fopen(names[i], "r");
+        if (!in) {
+            perror(names[i]);
+            status = 1;
+            break;
+        }
+        bool header = false, footer = false;
+        while (status == 0 && getline(&line, &cap, in) != -1) {
+            if (!header) {
+                header = true;
+                if (!merge_header(&mg, names[i], line))
+                    status = 1;
+            } else if (json_field(line, "stats")) {
+                footer = true;
+                merge_footer(&mg, line);
+            } else if (footer || !merge_record(&mg, names[i], line)) {
+                if (footer)
+                    fprintf(stderr, "Error: %s goes on after its footer.\n", names[i]);
+                status = 1;
             }
         }
-        // Rule A: Process commented-out print statements.
-        new_line = process_commented_print_line(lines[i]);
-        if (new_line) {
-            printf("Modified commented-out print in %s at line %zu.\n", filename, i+1);
-            fputs(new_line, fout);
-            free(new_line);
-            changes++;
-            continue;
+        if (status == 0 && !footer) {
+            fprintf(stderr, "Error: %s is incomplete (its run did not finish).\n", names[i]);
+            status = 1;
         }
-        // Rule B: Split inline comments.
-        new_line = split_inline_comment(lines[i]);
-        if (new_line) {
-            printf("Split inline comment in %s at line %zu.\n", filename, i+1);
-            fputs(new_line, fout);
-            free(new_line);
-            changes++;
-            continue;
+        fclose(in);
+    }
+    free(line);
+    unsigned missing = 0;
+    for (unsigned s = 0; status == 0 && s < mg.shards; s++)
+        if (!mg.seen[s]) {
+            fprintf(stderr, "Error: shard %u/%u is missing.\n", s + 1, mg.shards);
+            missing++;
         }
-        // Rule C: Merge consecutive full-line comments.
-        if (is_full_line_comment(lines[i]) && strlen(lines[i]) > MAX_LEN) {
-            size_t end_index;
-            new_line = merge_comment_block(lines, i, count, &end_index);
-            if (new_line) {
-                printf("Merged comment block in %s from line %zu to %zu.\n", filename, i+1, end_index);
-                fputs(new_line, fout);
-                free(new_line);
-                changes++;
-                i = end_index - 1;
-                continue;
+    if (missing)
+        status = 1;
+    if (status == 0) {
+        qsort(mg.files, mg.nfiles, sizeof(*mg.files), compare_merged_files);
+        size_t failed = 0;
+        for (size_t i = 0; i < mg.nfiles; i++) {
+            const struct merged_file *f = &mg.files[i];
+            if (strcmp(f->result, "failed") == 0) {
+                fprintf(stderr, "Error: %s could not be processed.\n", f->path);
+                failed++;
+            } else if (f->diff) {
+                fputs(f->diff, stdout);
+            } else if (strcmp(f->result, "changed") == 0) {
+                printf("Processed %s: %d modification(s) made.\n", f->path, f->changes);
+            } else if (strcmp(f->result, "not-idempotent") == 0) {
+                printf("Not idempotent: %s (%d block(s) change again).\n", f->path, f->changes);
+            } else {
+                printf("Would reformat %s: %d modification(s).\n", f->path, f->changes);
             }
         }
-        // Otherwise, write the line unchanged.
-        fputs(lines[i], fout);
+        fflush(stdout);
+        fprintf(stderr, "Merged %u shard(s) by %s: %zu file(s), %zu record(s), %zu failed.\n",
+                mg.shards, mg.by, mg.stats.files, mg.nfiles, failed);
+        if (strcmp(mg.mode, "verify") == 0)
+            fprintf(stderr, "%zu file(s) changed by the first pass, %zu of them not idempotent; "
+                            "rules: %.3f ms in the first pass, %.3f ms in the second.\n",
+                    mg.verified, mg.would_change, mg.pass_ns[0] / 1e6, mg.pass_ns[1] / 1e6);
+        else if (strcmp(mg.mode, "write") != 0)
+            fprintf(stderr, "%zu file(s) would be reformatted.\n", mg.would_change);
+        if (want_stats)
+            stats_report(stderr, &mg.stats, mg.wall_ns, stats_json);
+        if (mg.status != 0 || failed > 0 || (strcmp(mg.mode, "write") != 0 && mg.would_change > 0))
+            status = 1;
+    }
+    for (size_t i = 0; i < mg.nfiles; i++) {
+        free(mg.files[i].path);
+        free(mg.files[i].result);
+        free(mg.files[i].diff);
     }
-    for (size_t i = 0; i < count; i++)
-        free(lines[i]);
-    free(lines);
-    fclose(fout);
+    free(mg.files);
+    free(mg.seen);
+    free(mg.settings);
+    free(mg.target);
+    free(mg.mode);
+    free(mg.by);
+    stats_free(&mg.stats);
+    return status;
+}
 
-    if (rename(tmp_out, filename) != 0) {
-        perror("rename");
-        return;
+// ----------------- Benchmark -----------------
+
+/* format_pending_prints()
+ * Sends every pending Rule A snippet of the file to Black and waits for the results.
+ */
+static void format_pending_prints(const struct source *src, const struct rule_set *rules,
+                                  struct edit_list *edits, struct black_backend *bb,
+                                  struct arena *arena, struct run_stats *stats) {
+    struct print_queue q = {0};
+    for (size_t i = 0; i < edits->count; i++) {
+        if (edits->items[i].snippet && !queue_print(&q, bb, edits, i, arena)) {
+            perror("malloc");
+            break;
+        }
     }
-    printf("Processed %s: %d modification(s) made.\n", filename, changes);
+    finish_prints(&q, src, rules, edits, bb, arena, stats);
 }
 
-/* process_directory()
- * Recursively processes all files with a ".py" extension in the given directory.
+/* struct bench_spec
+ * Shape of the synthetic corpus: file count, approximate bytes per file, and the percentage
+ * of lines that are long inline comments, starts of comment runs, docstrings and commented-out
+ * prints (the rest is plain code).
  */
-void process_directory(const char *dir_path) {
-    DIR *dir = opendir(dir_path);
-    if (!dir) {
-        perror(dir_path);
-        return;
+struct bench_spec {
+    int files;
+    size_t size;
+    int inline_pct, run_pct, doc_pct, print_pct;
+    uint64_t seed;
+    bool black;
+};
+
+static const struct bench_spec bench_defaults = {
+    .files = 200, .size = 32 * 1024,
+    .inline_pct = 5, .run_pct = 4, .doc_pct = 2, .print_pct = 1,
+    .seed = 1, .black = true,
+};
+
+/* parse_bench_spec()
+ * Parses a comma-separated list of key=value settings ("files=500,size=65536,prints=0,black=0")
+ * over the defaults. Returns false on an unknown key or a bad value.
+ */
+static bool parse_bench_spec(const char *arg, struct bench_spec *spec) {
+    *spec = bench_defaults;
+    if (!arg)
+        return true;
+    char buf[BUFFER_SIZE];
+    snprintf(buf, sizeof(buf), "%s", arg);
+    char *saveptr;
+    for (char *item = strtok_r(buf, ",", &saveptr); item; item = strtok_r(NULL, ",", &saveptr)) {
+        char *eq = strchr(item, '=');
+        if (!eq) {
+            fprintf(stderr, "Error: bench setting '%s' needs a value.\n", item);
+            return false;
+        }
+        *eq = '\0';
+        char *end;
+        unsigned long long v = strtoull(eq + 1, &end, 10);
+        if (*end || eq[1] == '\0') {
+            fprintf(stderr, "Error: invalid value for bench setting '%s'.\n", item);
+            return false;
+        }
+        if (strcmp(item, "files") == 0 && v > 0 && v <= 1000000)
+            spec->files = (int)v;
+        else if (strcmp(item, "size") == 0 && v > 0 && v <= ((size_t)1 << 30))
+            spec->size = (size_t)v;
+        else if (strcmp(item, "inline") == 0 && v <= 100)
+            spec->inline_pct = (int)v;
+        else if (strcmp(item, "runs") == 0 && v <= 100)
+            spec->run_pct = (int)v;
+        else if (strcmp(item, "docstrings") == 0 && v <= 100)
+            spec->doc_pct = (int)v;
+        else if (strcmp(item, "prints") == 0 && v <= 100)
+            spec->print_pct = (int)v;
+        else if (strcmp(item, "seed") == 0)
+            spec->seed = v;
+        else if (strcmp(item, "black") == 0 && v <= 1)
+            spec->black = (v == 1);
+        else {
+            fprintf(stderr, "Error: unknown or out-of-range bench setting '%s'.\n", item);
+            return false;
+        }
     }
-    struct dirent *entry;
-    char path[BUFFER_SIZE];
-    while ((entry = readdir(dir)) != NULL) {
-        // Skip "." and ".."
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
-            continue;
-        snprintf(path, sizeof(path), "%s/%s", dir_path, entry->d_name);
-        struct stat st;
-        if (stat(path, &st) == -1) {
-            perror(path);
-            continue;
+    if (spec->inline_pct + spec->run_pct + spec->doc_pct + spec->print_pct > 100) {
+        fprintf(stderr, "Error: bench line percentages add up to more than 100.\n");
+        return false;
+    }
+    return true;
+}
+
+/* bench_rand()
+ * splitmix64: small, fast and good enough to make the corpus reproducible from a seed.
+ */
+static uint64_t bench_rand(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static size_t bench_range(uint64_t *rng, size_t lo, size_t hi) {
+    return lo + (size_t)(bench_rand(rng) % (hi - lo + 1));
+}
+
+/* bench_words()
+ * Appends words (with the occasional comma or period) until about 'target' bytes are written.
+ */
+static bool bench_words(struct strbuf *out, uint64_t *rng, size_t target) {
+    static const char *const words[] = {
+        "the", "value", "is", "computed", "from", "input", "buffer", "when", "cache", "entry",
+        "returns", "None", "otherwise", "we", "retry", "request", "after", "timeout", "and",
+        "update", "state", "for", "each", "worker", "thread", "so", "that", "results", "stay",
+        "consistent", "across", "calls", "see", "issue", "configuration", "parser", "token",
+    };
+    size_t start = out->len;
+    while (out->len - start < target) {
+        const char *w = words[bench_rand(rng) % (sizeof(words) / sizeof(words[0]))];
+        if (out->len > start && !strbuf_append(out, " ", 1))
+            return false;
+        if (!strbuf_append(out, w, strlen(w)))
+            return false;
+        unsigned p = bench_rand(rng) % 16;
+        if ((p == 0 && !strbuf_append(out, ",", 1)) || (p == 1 && !strbuf_append(out, ".", 1)))
+            return false;
+    }
+    return true;
+}
+
+/* bench_generate()
+ * Appends one synthetic Python file of about spec->size bytes to 'out'.
+ */
+static bool bench_generate(struct strbuf *out, const struct bench_spec *spec, uint64_t *rng) {
+    bool ok = true;
+    for (unsigned n = 0; ok && out->len < spec->size; n++) {
+        size_t indent = 4 * bench_range(rng, 0, 2);
+        char code[128];
+        int code_len = snprintf(code, sizeof(code), "result_%u = compute_%u(alpha, beta, gamma)",
+                                n, (unsigned)(bench_rand(rng) % 1000));
+        int roll = (int)(bench_rand(rng) % 100);
+        ok = strbuf_pad(out, ' ', indent);
+        if ((roll -= spec->inline_pct) < 0) {
+            ok = ok && strbuf_append(out, code, code_len) && strbuf_append(out, "  # ", 4) &&
+                 bench_words(out, rng, bench_range(rng, 40, 90)) && strbuf_append(out, "\n", 1);
+        } else if ((roll -= spec->run_pct) < 0) {
+            size_t lines = bench_range(rng, 2, 5);
+            for (size_t k = 0; ok && k < lines; k++) {
+                ok = (k == 0 || strbuf_pad(out, ' ', indent)) && strbuf_append(out, "# ", 2) &&
+                     bench_words(out, rng, bench_range(rng, 60, 110)) && strbuf_append(out, "\n", 1);
+            }
+        } else if ((roll -= spec->doc_pct) < 0) {
+            size_t lines = bench_range(rng, 1, 4);
+            ok = ok && strbuf_append(out, "\"\"\"", 3) && bench_words(out, rng, bench_range(rng, 20, 70)) &&
+                 strbuf_append(out, "\n", 1);
+            for (size_t k = 0; ok && k < lines; k++) {
+                ok = strbuf_pad(out, ' ', indent) && bench_words(out, rng, bench_range(rng, 50, 100)) &&
+                     strbuf_append(out, "\n", 1);
+            }
+            ok = ok && strbuf_pad(out, ' ', indent) && strbuf_append(out, "\"\"\"\n", 4);
+        } else if ((roll -= spec->print_pct) < 0) {
+            ok = ok && strbuf_append(out, "# print(\"", 9) && bench_words(out, rng, bench_range(rng, 50, 80)) &&
+                 strbuf_append(out, "\", result, sep=\", \", end=\"\")\n", 29);
+        } else {
+            ok = ok && strbuf_append(out, code, code_len) && strbuf_append(out, "\n", 1);
         }
-        if (S_ISDIR(st.st_mode)) {
-            process_directory(path);
-        } else if (S_ISREG(st.st_mode)) {
-            // Process only .py files.
-            const char *ext = strrchr(entry->d_name, '.');
-            if (ext && strcmp(ext, ".py") == 0) {
-                process_file(path);
+    }
+    return ok;
+}
+
+/* run_bench()
+ * Generates the corpus described by 'spec' in memory and runs every file through the pipeline
+ * (line index and pre-scan, rules, Black, output assembly) with the output going to /dev/null.
+ * Prints throughput for the native stages and, separately, the time spent in Black, followed by
+ * per-rule counts and time per line. Only the rules in 'rules' run. 'bb' may be NULL to leave
+ * Rule A snippets unformatted. Returns 0 on success and 1 on failure.
+ */
+int run_bench(const struct bench_spec *spec, const struct rule_set *rule_set, struct black_backend *bb) {
+    int sink = open("/dev/null", O_WRONLY);
+    if (sink == -1) {
+        perror("/dev/null");
+        return 1;
+    }
+    uint64_t rng = spec->seed;
+    struct strbuf corpus = {0};
+    struct arena arena = {0};
+    struct rule_stats rules = {0};
+    uint64_t scan_ns = 0, rules_ns = 0, black_ns = 0, emit_ns = 0;
+    size_t bytes = 0, lines = 0, snippets = 0;
+    int status = 0;
+    for (int f = 0; f < spec->files && status == 0; f++) {
+        corpus.len = 0;
+        if (!bench_generate(&corpus, spec, &rng)) {
+            perror("malloc");
+            status = 1;
+            break;
+        }
+        struct source src = {.data = corpus.data, .size = corpus.len, .width = rule_set->width,
+                             .wrap = rule_set->wrap, .fd = -1};
+        struct edit_list edits = {0};
+        bool ok = true;
+        uint64_t t0 = now_ns();
+        if (scan_source(&src) != 0) {
+            perror("realloc");
+            status = 1;
+            break;
+        }
+        uint64_t t1 = now_ns();
+        for (size_t i = 0; i < src.count && ok && src.candidates > 0; i++) {
+            struct edit e;
+            if (rule_set->apply(&src, i, &e, &arena, &rules)) {
+                ok = add_edit(&edits, &e);
+                i = e.end - 1;
             }
         }
+        uint64_t t2 = now_ns();
+        size_t pending = 0;
+        for (size_t i = 0; i < edits.count; i++)
+            pending += (edits.items[i].snippet != NULL);
+        if (bb)
+            format_pending_prints(&src, rule_set, &edits, bb, &arena, NULL);
+        uint64_t t3 = now_ns();
+        if (!emit_edits(sink, &src, &edits, NULL, NULL)) {
+            perror("/dev/null");
+            status = 1;
+        }
+        uint64_t t4 = now_ns();
+        if (!ok) {
+            perror("realloc");
+            status = 1;
+        }
+        scan_ns += t1 - t0;
+        rules_ns += t2 - t1;
+        black_ns += t3 - t2;
+        emit_ns += t4 - t3;
+        bytes += src.size;
+        lines += src.count;
+        snippets += pending;
+        free_edits(&edits);
+        arena_reset(&arena);
+        free(src.lines);
     }
-    closedir(dir);
+    strbuf_free(&corpus);
+    arena_free(&arena);
+    close(sink);
+    if (status != 0)
+        return status;
+
+    uint64_t native_ns = scan_ns + rules_ns + emit_ns;
+    double mb = bytes / 1e6;
+    printf("Benchmark: %d files, %.2f MB, %zu lines (seed %llu)\n",
+           spec->files, mb, lines, (unsigned long long)spec->seed);
+    printf("  %-8s %12s\n", "stage", "time (ms)");
+    printf("  %-8s %12.3f\n", "scan", scan_ns / 1e6);
+    printf("  %-8s %12.3f\n", "rules", rules_ns / 1e6);
+    printf("  %-8s %12.3f\n", "emit", emit_ns / 1e6);
+    if (bb)
+        printf("  %-8s %12.3f   %zu snippet(s), %s\n", "black", black_ns / 1e6, snippets, bb->version);
+    else
+        printf("  %-8s %12s   %zu snippet(s) not formatted\n", "black", "-", snippets);
+    double native_s = native_ns / 1e9, total_s = (native_ns + black_ns) / 1e9;
+    if (native_s > 0)
+        printf("  %-8s %12.3f   %.1f files/s, %.2f MB/s\n", "native", native_ns / 1e6,
+               spec->files / native_s, mb / native_s);
+    if (total_s > 0)
+        printf("  %-8s %12.3f   %.1f files/s, %.2f MB/s\n", "total", (native_ns + black_ns) / 1e6,
+               spec->files / total_s, mb / total_s);
+    printf("  %-5s %10s %10s %12s %9s\n", "rule", "tried", "applied", "time (ms)", "ns/line");
+    for (int r = RULE_A; r <= RULE_D; r++) {
+        printf("  %-5c %10zu %10zu %12.3f %9.1f\n", 'A' + r, rules.tried[r], rules.applied[r],
+               rules.ns[r] / 1e6, rules.tried[r] ? (double)rules.ns[r] / rules.tried[r] : 0.0);
+    }
+    return 0;
 }
 
 // ----------------- Main -----------------
 
+/* usage()
+ * Prints the command-line synopsis to stderr.
+ */
+static void usage(const char *prog) {
+    int pad = (int)strlen(prog);
+    fprintf(stderr, "Usage: %s [-j N] [--file-jobs N] [--black-workers N]\n"
+                    "       %*s [--check | --diff | --verify-idempotent]\n"
+                    "       %*s [--since REV] [--cache[=FILE]] [--snippet-cache=FILE] [--exclude GLOB]...\n"
+                    "       %*s [--no-ignore] [--stats[=json]] [--line-length N] [--rules SET]\n"
+                    "       %*s [--wrap=greedy|optimal] [--shard I/N [--shard-by hash|size]]\n"
+                    "       %*s [--emit-manifest FILE] [--daemon[=SOCKET]] <path>\n"
+                    "       %s [--stats[=json]] --merge-results MANIFEST...\n"
+                    "       %s [--black-workers N] [--line-length N] [--rules SET] [--wrap=MODE]\n"
+                    "       %*s --bench[=SPEC]\n",
+            prog, pad, "", pad, "", pad, "", pad, "", pad, "", prog, prog, pad, "");
+}
+
+/* parse_count()
+ * Parses the thread count 'arg' of an option: 0 means one per online CPU.
+ * Returns false (after printing an error naming 'what') if it is not a number in [0, 4096].
+ */
+static bool parse_count(const char *arg, const char *what, int *count) {
+    char *end;
+    long n = strtol(arg, &end, 10);
+    if (!*arg || *end || n < 0 || n > 4096) {
+        fprintf(stderr, "Error: invalid %s '%s'.\n", what, arg);
+        return false;
+    }
+    *count = (n == 0) ? (int)sysconf(_SC_NPROCESSORS_ONLN) : (int)n;
+    if (*count < 1)
+        *count = 1;
+    return true;
+}
+
+/* parse_rules()
+ * Parses the --rules argument, a set of rule letters such as "ABD" (in any order and case), into
+ * a mask of RULE_BIT()s. Returns false (after printing an error) if it names no or unknown rules.
+ */
+static bool parse_rules(const char *arg, unsigned *mask) {
+    *mask = 0;
+    for (const char *p = arg; *p; p++) {
+        char c = (char)toupper((unsigned char)*p);
+        if (c < 'A' || c > 'D') {
+            fprintf(stderr, "Error: unknown rule '%c' in '%s' (rules are A, B, C and D).\n", *p, arg);
+            return false;
+        }
+        *mask |= RULE_BIT(c - 'A');
+    }
+    if (*mask == 0) {
+        fprintf(stderr, "Error: --rules needs at least one rule.\n");
+        return false;
+    }
+    return true;
+}
+
+/* rules_name()
+ * Writes the letters of the rules in 'mask' to buf (at least five bytes), e.g. "ABCD".
+ */
+static const char *rules_name(unsigned mask, char *buf) {
+    char *p = buf;
+    for (int r = RULE_A; r <= RULE_D; r++)
+        if (mask & RULE_BIT(r))
+            *p++ = (char)('A' + r);
+    *p = '\0';
+    return buf;
+}
+
 /* main()
- * Usage: reformat_print <path>
+ * Usage: reformat_print [-j N] [--file-jobs N] [--black-workers N]
+ *                       [--check | --diff | --verify-idempotent]
+ *                       [--since REV] [--cache[=FILE]] [--snippet-cache=FILE] [--exclude GLOB]...
+ *                       [--no-ignore] [--stats[=json]] [--line-length N] [--rules SET]
+ *                       [--wrap=greedy|optimal] [--shard I/N [--shard-by hash|size]]
+ *                       [--emit-manifest FILE] [--daemon[=SOCKET]] <path>
+ *        reformat_print [--stats[=json]] --merge-results MANIFEST...
+ * If <path> is "-", filter stdin to stdout (progress messages go to stderr).
  * If <path> is a file, process that file.
- * If <path> is a directory, recursively process all ".py" files within.
+ * If <path> is a directory, recursively process all ".py" files within; with -j N the files
+ * are processed by N worker threads (-j 0 uses one per online CPU), which also share the walk.
+ * The walk skips .git, .hg, .svn, node_modules and __pycache__ directories and what the
+ * .gitignore files it finds exclude, unless --no-ignore is given; --exclude GLOB (repeatable)
+ * skips entries whose name, or path below <path> if GLOB has a '/', matches GLOB.
+ * --file-jobs N (default 1, 0 for one per online CPU) runs the rules of every file of at least
+ * FILE_SPLIT_MIN bytes on N threads (see find_edits_split()), in each of the -j workers.
+ * --black-workers N runs N Black helpers (default 1, 0 for one per online CPU) that Rule A
+ * snippets from any file are queued to, independently of -j.
+ * --line-length N (20 to 1000, default 79) sets the limit the rules and Black enforce, and
+ * --rules SET (letters from "ABCD", default all) the rules that are applied.
+ * --wrap=optimal has Rules C and D wrap with wrap_text_optimal_into() instead of the default
+ * greedy wrap_text_into().
+ * With --cache, files found clean are recorded in FILE (default: .reflow_cache in the target
+ * directory) and skipped on later runs with the same settings and Black version.
+ * With --snippet-cache=FILE, Black results are loaded from and saved to FILE, so snippets
+ * formatted by an earlier run with the same line length and Black version are looked up.
+ * With --check, files that would change are listed; with --diff, their changes are printed as
+ * unified diffs. Neither writes anything, and both exit with status 1 if any file would change.
+ * With --verify-idempotent, nothing is written either: each file's result is run through the
+ * rules a second time in memory, files it would change again are listed with the blocks, and
+ * the time each pass took is printed; the exit status is 1 if any file does not converge.
+ * With --since REV, only .py files that "git diff REV" reports as changed are processed, and
+ * only blocks that overlap their changed lines are rewritten.
+ * With --stats, a summary of time per stage and rule, counters and Black latency percentiles is
+ * printed to stderr at the end of the run (--stats=json prints it as one JSON object).
+ * With --shard I/N, only the files of shard I of N are processed: those whose path below <path>
+ * hashes to it, or with --shard-by=size, those shard_plan() gives it. With --emit-manifest FILE,
+ * the files that changed, would change or failed (with their diffs), the exit status and the
+ * statistics are written to FILE (see manifest_open()). --merge-results combines the manifests
+ * of all shards of a run (see merge_results()).
+ * With --daemon, the directory is processed and then watched until SIGINT or SIGTERM (see
+ * run_daemon()); requests are taken on SOCKET (default: .reflow.sock in the directory). The
+ * cache is always kept in memory, and also in a file if --cache is given.
+ * With --bench, no path is given: a synthetic corpus is processed in memory instead (see
+ * parse_bench_spec() for SPEC) and a timing report is printed.
+ * Exits with status 1 if any file could not be processed.
  */
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s <path>\n", argv[0]);
-        return 1;
+    static const struct option long_options[] = {
+        {"cache", optional_argument, NULL, 'c'},
+        {"bench", optional_argument, NULL, 'b'},
+        {"stats", optional_argument, NULL, 's'},
+        {"check", no_argument, NULL, 'k'},
+        {"since", required_argument, NULL, 'S'},
+        {"diff", no_argument, NULL, 'd'},
+        {"black-workers", required_argument, NULL, 'w'},
+        {"file-jobs", required_argument, NULL, 'F'},
+        {"snippet-cache", required_argument, NULL, 'm'},
+        {"exclude", required_argument, NULL, 'x'},
+        {"no-ignore", no_argument, NULL, 'n'},
+        {"daemon", optional_argument, NULL, 'D'},
+        {"line-length", required_argument, NULL, 'L'},
+        {"rules", required_argument, NULL, 'R'},
+        {"wrap", required_argument, NULL, 'W'},
+        {"verify-idempotent", no_argument, NULL, 'V'},
+        {"shard", required_argument, NULL, 'H'},
+        {"shard-by", required_argument, NULL, 'B'},
+        {"emit-manifest", required_argument, NULL, 'E'},
+        {"merge-results", no_argument, NULL, 'M'},
+        {NULL, 0, NULL, 0},
+    };
+    int jobs = 1, black_workers = 1, file_jobs = 1;
+    bool use_cache = false;
+    const char *cache_file = NULL;
+    bool bench = false;
+    struct bench_spec spec;
+    bool want_stats = false, stats_json = false;
+    enum output_mode mode = OUTPUT_WRITE;
+    const char *since = NULL;
+    const char *snippet_cache = NULL;
+    bool daemon_mode = false;
+    const char *socket_path = NULL;
+    int line_length = MAX_LEN;
+    unsigned rule_mask = RULES_ALL;
+    enum wrap_mode wrap = WRAP_GREEDY;
+    struct shard shard = {0};
+    bool sharded = false, merge = false;
+    const char *manifest_file = NULL;
+    struct walk_options walk = {0};
+    // From here on every exit goes through 'out', which releases whatever has been set up.
+    int status = 1;
+    struct run_context ctx = {0};
+    struct run_stats stats = {0};
+    struct black_backend bb;
+    bool black_started = false;
+    walk.excludes = calloc(argc, sizeof(char *));
+    if (!walk.excludes) {
+        perror("calloc");
+        goto out;
     }
-    if (!check_black_available()) {
-        fprintf(stderr, "Error: 'black' is not available in your PATH. Please install it (e.g., pip install black).\n");
-        return 1;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "j:", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'j':
+            if (!parse_count(optarg, "job count", &jobs))
+                goto out;
+            break;
+        case 'w':
+            if (!parse_count(optarg, "Black worker count", &black_workers))
+                goto out;
+            break;
+        case 'F':
+            if (!parse_count(optarg, "file job count", &file_jobs))
+                goto out;
+            break;
+        case 'c':
+            use_cache = true;
+            cache_file = optarg;
+            break;
+        case 'b':
+            if (!parse_bench_spec(optarg, &spec))
+                goto out;
+            bench = true;
+            break;
+        case 's':
+            if (optarg && strcmp(optarg, "json") != 0) {
+                fprintf(stderr, "Error: unknown stats format '%s'.\n", optarg);
+                goto out;
+            }
+            want_stats = true;
+            stats_json = (optarg != NULL);
+            break;
+        case 'S':
+            since = optarg;
+            break;
+        case 'm':
+            snippet_cache = optarg;
+            break;
+        case 'x':
+            walk.excludes[walk.nexcludes++] = optarg;
+            break;
+        case 'n':
+            walk.no_ignore = true;
+            break;
+        case 'D':
+            daemon_mode = true;
+            socket_path = optarg;
+            break;
+        case 'L': {
+            char *end;
+            long n = strtol(optarg, &end, 10);
+            if (!*optarg || *end || n < 20 || n > 1000) {
+                fprintf(stderr, "Error: invalid line length '%s' (must be 20 to 1000).\n", optarg);
+                goto out;
+            }
+            line_length = (int)n;
+            break;
+        }
+        case 'R':
+            if (!parse_rules(optarg, &rule_mask))
+                goto out;
+            break;
+        case 'W':
+            if (strcmp(optarg, "greedy") == 0) {
+                wrap = WRAP_GREEDY;
+            } else if (strcmp(optarg, "optimal") == 0) {
+                wrap = WRAP_OPTIMAL;
+            } else {
+                fprintf(stderr, "Error: unknown wrap mode '%s' (use greedy or optimal).\n", optarg);
+                goto out;
+            }
+            break;
+        case 'k':
+        case 'd':
+            mode = (opt == 'k') ? OUTPUT_CHECK : OUTPUT_DIFF;
+            break;
+        case 'V':
+            mode = OUTPUT_VERIFY;
+            break;
+        case 'H':
+            if (!parse_shard(optarg, &shard))
+                goto out;
+            sharded = true;
+            break;
+        case 'B':
+            if (strcmp(optarg, "hash") != 0 && strcmp(optarg, "size") != 0) {
+                fprintf(stderr, "Error: unknown shard split '%s' (use hash or size).\n", optarg);
+                goto out;
+            }
+            shard.by_size = (optarg[0] == 's');
+            break;
+        case 'E':
+            manifest_file = optarg;
+            break;
+        case 'M':
+            merge = true;
+            break;
+        default:
+            usage(argv[0]);
+            goto out;
+        }
+    }
+    if (merge) {
+        if (optind == argc) {
+            usage(argv[0]);
+            goto out;
+        }
+        status = merge_results(argv + optind, argc - optind, want_stats, stats_json);
+        goto out;
+    }
+    if (optind != argc - (bench ? 0 : 1)) {
+        usage(argv[0]);
+        goto out;
+    }
+    if (daemon_mode && (bench || since || mode != OUTPUT_WRITE)) {
+        fprintf(stderr, "Error: --daemon cannot be combined with --bench, --since, --check, --diff "
+                        "or --verify-idempotent.\n");
+        goto out;
+    }
+    // The second pass sees whole files, so it would flag blocks --since left alone.
+    if (mode == OUTPUT_VERIFY && since) {
+        fprintf(stderr, "Error: --verify-idempotent cannot be combined with --since.\n");
+        goto out;
+    }
+    if ((sharded || manifest_file) && (bench || daemon_mode || strcmp(argv[optind], "-") == 0)) {
+        fprintf(stderr, "Error: --shard and --emit-manifest need a file or directory, and cannot be "
+                        "combined with --bench or --daemon.\n");
+        goto out;
+    }
+    // A dead helper must surface as a write error, not kill the tool.
+    signal(SIGPIPE, SIG_IGN);
+    struct rule_set rules;
+    rule_set_init(&rules, rule_mask, line_length, wrap);
+    if (bench) {
+        // Without Black the native stages are still measured; snippets stay unformatted.
+        bool have_black = false;
+        if (spec.black) {
+            have_black = black_start(&bb, black_workers, line_length);
+            black_started = true;
+            if (!have_black && check_black_available()) {
+                black_cli_version(&bb);
+                have_black = true;
+            }
+            if (!have_black)
+                fprintf(stderr, "Warning: 'black' is not available; Rule A snippets are not formatted.\n");
+        }
+        status = run_bench(&spec, &rules, have_black ? &bb : NULL);
+        goto out;
+    }
+    const char *target = argv[optind];
+    black_started = true;
+    if (!black_start(&bb, black_workers, line_length)) {
+        if (!check_black_available()) {
+            fprintf(stderr, "Error: 'black' is not available in your PATH. Please install it (e.g., pip install black).\n");
+            goto out;
+        }
+        black_cli_version(&bb);
     }
+    if (snippet_cache) {
+        char settings[256];
+        snprintf(settings, sizeof(settings), "max_len=%d black=%s", line_length, bb.version);
+        memo_open(&bb.memo, snippet_cache, xxh64(settings, strlen(settings), 0));
+    }
+    ctx.rules = rules;
+    ctx.bb = &bb;
+    ctx.walk = &walk;
+    ctx.mode = mode;
+    ctx.file_jobs = file_jobs;
+    uint64_t start_ns = now_ns();
+    if (want_stats)
+        ctx.stats = &stats;
     struct stat st;
-    if (stat(argv[1], &st) == -1) {
-        perror(argv[1]);
-        return 1;
+    bool have_stat = (strcmp(target, "-") != 0 && stat(target, &st) == 0);
+    struct file_cache cache;
+    // The daemon always keeps a cache, if only in memory.
+    if ((use_cache || daemon_mode) && have_stat) {
+        // Keys are relative to the target directory (or a file target's directory).
+        char root[BUFFER_SIZE];
+        snprintf(root, sizeof(root), "%s", target);
+        if (!S_ISDIR(st.st_mode)) {
+            char *slash = strrchr(root, '/');
+            if (slash)
+                *slash = '\0';
+            else
+                snprintf(root, sizeof(root), ".");
+        }
+        size_t n = strlen(root);
+        while (n > 1 && root[n-1] == '/')
+            root[--n] = '\0';
+        char default_file[BUFFER_SIZE + 16];
+        snprintf(default_file, sizeof(default_file), "%s/.reflow_cache", root);
+        char settings[256], names[5];
+        snprintf(settings, sizeof(settings), "max_len=%d rules=%s wrap=%s black=%s", line_length,
+                 rules_name(rule_mask, names), wrap == WRAP_OPTIMAL ? "optimal" : "greedy",
+                 bb.version);
+        const char *file = !use_cache ? "" : cache_file ? cache_file : default_file;
+        if (!cache_open(&cache, file, root, xxh64(settings, strlen(settings), 0))) {
+            perror("cache");
+            goto out;
+        }
+        ctx.cache = &cache;
+    }
+    struct change_set changes;
+    if (since) {
+        if (!have_stat) {
+            fprintf(stderr, "Error: --since needs a file or directory in a git work tree.\n");
+            goto out;
+        }
+        // Paths must come out spelled the way the target was given.
+        char root[BUFFER_SIZE];
+        const char *pathspec = ".";
+        snprintf(root, sizeof(root), "%s", target);
+        if (!S_ISDIR(st.st_mode)) {
+            char *slash = strrchr(root, '/');
+            pathspec = slash ? target + (slash - root) + 1 : target;
+            if (slash == root)
+                root[1] = '\0';  // "/file.py"
+            else if (slash)
+                *slash = '\0';
+            else
+                root[0] = '\0';
+        }
+        // A partly loaded set is freed at 'out' too.
+        ctx.changes = &changes;
+        if (!change_set_load(&changes, root, pathspec, since))
+            goto out;
+    }
+    struct manifest manifest;
+    if (have_stat && (sharded || manifest_file)) {
+        // Paths are told apart below the target directory (or a file target's directory).
+        const char *slash = strrchr(target, '/');
+        size_t root_len = S_ISDIR(st.st_mode) ? strlen(target) : slash ? (size_t)(slash - target) : 0;
+        shard.root_len = root_len;
+        if (sharded && shard.by_size &&
+            shard_plan(&shard, target, &ctx, S_ISDIR(st.st_mode)) != 0)
+            goto out;
+        if (sharded)
+            ctx.shard = &shard;
+        char settings[256], names[5];
+        snprintf(settings, sizeof(settings), "max_len=%d rules=%s wrap=%s black=%s", line_length,
+                 rules_name(rule_mask, names), wrap == WRAP_OPTIMAL ? "optimal" : "greedy",
+                 bb.version);
+        if (manifest_file) {
+            if (!manifest_open(&manifest, manifest_file, ctx.shard, mode, settings, target,
+                               root_len))
+                goto out;
+            ctx.manifest = &manifest;
+            // The footer carries the statistics, whether or not they are printed.
+            ctx.stats = &stats;
+        }
     }
-    if (S_ISDIR(st.st_mode)) {
-        process_directory(argv[1]);
+    status = 0;
+    if (strcmp(target, "-") == 0 && mode != OUTPUT_WRITE) {
+        // Comparing needs the whole input, so stdin is read like a file.
+        struct arena arena = {0};
+        status = (process_file_as("/dev/stdin", "<stdin>", &ctx, &arena, ctx.stats, stdout) != 0);
+        arena_free(&arena);
+    } else if (strcmp(target, "-") == 0) {
+        status = (process_stream(stdin, stdout, "<stdin>", &ctx, stderr) != 0);
+    } else if (!have_stat) {
+        perror(target);
+        status = 1;
+    } else if (daemon_mode) {
+        if (S_ISDIR(st.st_mode)) {
+            char default_socket[BUFFER_SIZE + 16];
+            snprintf(default_socket, sizeof(default_socket), "%s/.reflow.sock", cache.root);
+            status = (run_daemon(target, socket_path ? socket_path : default_socket, &ctx) != 0);
+        } else {
+            fprintf(stderr, "Error: --daemon needs a directory.\n");
+            status = 1;
+        }
+    } else if (S_ISDIR(st.st_mode)) {
+        int ret = (jobs > 1) ? process_directory_parallel(target, &ctx, jobs)
+                             : process_directory(target, &ctx);
+        status = (ret != 0);
     } else if (S_ISREG(st.st_mode)) {
-        process_file(argv[1]);
+        struct arena arena = {0};
+        status = (process_file(target, &ctx, &arena, ctx.stats, stdout) != 0);
+        arena_free(&arena);
     } else {
-        fprintf(stderr, "Error: %s is not a regular file or directory.\n", argv[1]);
-        return 1;
+        fprintf(stderr, "Error: %s is not a regular file or directory.\n", target);
+        status = 1;
     }
-    return 0;
+    size_t would_change = atomic_load(&ctx.would_change);
+    if (mode == OUTPUT_VERIFY) {
+        fflush(stdout);
+        double first_ms = atomic_load(&ctx.pass_ns[0]) / 1e6;
+        double second_ms = atomic_load(&ctx.pass_ns[1]) / 1e6;
+        fprintf(stderr, "%zu file(s) changed by the first pass, %zu of them not idempotent.\n",
+                atomic_load(&ctx.verified), would_change);
+        fprintf(stderr, "Rules: %.3f ms in the first pass, %.3f ms in the second", first_ms,
+                second_ms);
+        if (first_ms > 0)
+            fprintf(stderr, " (%.1f%% of the first)", 100.0 * second_ms / first_ms);
+        fprintf(stderr, ".\n");
+        if (would_change > 0)
+            status = 1;
+    } else if (mode != OUTPUT_WRITE) {
+        fflush(stdout);
+        fprintf(stderr, "%zu file(s) would be reformatted.\n", would_change);
+        if (would_change > 0)
+            status = 1;
+    }
+    if (ctx.manifest &&
+        !manifest_close(ctx.manifest, manifest_file, &ctx, &stats, now_ns() - start_ns, status))
+        status = 1;
+    if (want_stats) {
+        fflush(stdout);  // Keep the report after the progress messages.
+        stats_report(stderr, &stats, now_ns() - start_ns, stats_json);
+    }
+out:
+    stats_free(&stats);
+    shard_free(&shard);
+    if (ctx.changes)
+        change_set_free(&changes);
+    if (ctx.cache)
+        cache_close(ctx.cache);
+    if (black_started)
+        black_stop(&bb);
+    free(walk.excludes);
+    return status;
 }
 
+#endif /* REFLOW_NO_MAIN */
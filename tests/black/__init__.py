@@ -0,0 +1,39 @@
+"""Stand-in for Black used by tests/run.sh.
+
+It formats just enough like Black for the golden outputs to be stable: a line longer than the
+line length that contains a call is split into one argument per line. Input that is not valid
+Python is rejected with InvalidInput, as Black rejects it.
+"""
+
+__version__ = "0.0-stub"
+
+
+class Mode:
+    def __init__(self, line_length=88, **kwargs):
+        self.line_length = line_length
+
+
+class InvalidInput(Exception):
+    pass
+
+
+def format_str(src, mode):
+    try:
+        compile(src, "<snippet>", "exec")
+    except SyntaxError as e:
+        raise InvalidInput(str(e))
+    out = []
+    for line in src.splitlines():
+        if len(line) <= mode.line_length or "(" not in line:
+            out.append(line.rstrip())
+            continue
+        head, _, rest = line.partition("(")
+        rest = rest.rstrip()
+        if rest.endswith(")"):
+            rest = rest[:-1]
+        out.append(head + "(")
+        for arg in rest.split(","):
+            if arg.strip():
+                out.append("    " + arg.strip() + ",")
+        out.append(")")
+    return "\n".join(out) + "\n"
@@ -0,0 +1,31 @@
+"""Command-line entry of the stub: black [--line-length N] [--version] FILE..."""
+
+import sys
+
+import black
+
+args = sys.argv[1:]
+line_length = 88
+files = []
+i = 0
+while i < len(args):
+    if args[i] == "--line-length":
+        line_length = int(args[i + 1])
+        i += 2
+        continue
+    if args[i] == "--version":
+        print("black, %s" % black.__version__)
+        sys.exit(0)
+    if not args[i].startswith("-"):
+        files.append(args[i])
+    i += 1
+for name in files:
+    with open(name) as f:
+        src = f.read()
+    try:
+        result = black.format_str(src, mode=black.Mode(line_length=line_length))
+    except black.InvalidInput as e:
+        print("error: cannot format %s: %s" % (name, e), file=sys.stderr)
+        sys.exit(123)
+    with open(name, "w") as f:
+        f.write(result)
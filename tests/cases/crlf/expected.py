@@ -0,0 +1,12 @@
+x = 1
+"""
+a comment in a file with CRLF line endings that is long enough to get merged by
+C
+ second line
+"""
+# an inline comment in a CRLF file that is long enough to be split by Rule B
+y = 2
+"""
+A CRLF docstring whose single line is much longer than the limit and has to
+be reflowed by D.
+"""
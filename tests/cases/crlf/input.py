@@ -0,0 +1,7 @@
+x = 1
+# a comment in a file with CRLF line endings that is long enough to get merged by C
+# second line
+y = 2  # an inline comment in a CRLF file that is long enough to be split by Rule B
+"""
+A CRLF docstring whose single line is much longer than the limit and has to be reflowed by D.
+"""
@@ -0,0 +1,8 @@
+URL = "https://example.com/path#fragment-that-makes-this-line-quite-a-bit-longer-than-allowed"
+# red is used for errors in the terminal output, warnings get yellow instead
+COLOR = '#ff0000'
+# matches commented-out prints like the ones Rule A sees
+PATTERN = r"^\s*#\s*(print|log)\(.*\)$"
+MULTI = """
+# this looks like a comment but it sits inside a triple-quoted string and must stay as it is okay
+"""
@@ -0,0 +1,6 @@
+URL = "https://example.com/path#fragment-that-makes-this-line-quite-a-bit-longer-than-allowed"
+COLOR = '#ff0000'  # red is used for errors in the terminal output, warnings get yellow instead
+PATTERN = r"^\s*#\s*(print|log)\(.*\)$"  # matches commented-out prints like the ones Rule A sees
+MULTI = """
+# this looks like a comment but it sits inside a triple-quoted string and must stay as it is okay
+"""
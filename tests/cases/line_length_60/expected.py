@@ -0,0 +1,10 @@
+def f(x):
+    # an inline comment that fits in 79 but not in 60
+    y = x + 1
+    """
+    A comment run that fits in seventy-nine columns easily
+    but not in sixty.
+     print("a print that fits in 79
+    columns", x, y, "ok")
+    """
+    return y
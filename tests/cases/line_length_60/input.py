@@ -0,0 +1,6 @@
+def f(x):
+    y = x + 1  # an inline comment that fits in 79 but not in 60
+    # A comment run that fits in seventy-nine columns easily
+    # but not in sixty.
+    # print("a print that fits in 79 columns", x, y, "ok")
+    return y
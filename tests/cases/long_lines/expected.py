@@ -0,0 +1,256 @@
+x = 1
+"""
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod
+"""
+# lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod
+y = 2
+"""
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor
+lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod
+"""
+# trailing comment after a very long string literal
+z = 'aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa'
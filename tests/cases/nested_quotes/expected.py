@@ -0,0 +1,10 @@
+def quotes():
+    """
+    A docstring that mentions 'single' and "double" quotes and even a '''
+    triple single quote inside.
+    """
+    s = '''a triple-single string with """ inside it, # and a hash, that goes past the line limit'''
+    t = "it's a \"quoted\" word # not a comment at all, even though this line is long enough ok"
+    u = f"{'nested'!r} and {s!r:>10} in an f-string # still not a comment, and long enough here"
+    # this one is a real comment that is long enough to be split by Rule B
+    return s, t, u
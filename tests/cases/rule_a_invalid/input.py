@@ -0,0 +1,5 @@
+def broken():
+    # print("this is not valid python because the parenthesis never closes", ((
+    # and this comment continues the run that the broken print line starts above
+    # short tail
+    return None
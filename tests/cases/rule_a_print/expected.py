@@ -0,0 +1,17 @@
+def report(total, items):
+    """
+    print(
+        "processed a batch of items and the running total is now",
+        total,
+        len(items),
+    )
+    """
+    # print('short enough')
+    if total:
+        """
+        print(
+            f"the total {total} came from {len(items)} items in this particular batch",
+        )
+        """
+        return total
+    return 0
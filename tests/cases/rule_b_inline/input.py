@@ -0,0 +1,5 @@
+def area(width, height):
+    result = width * height  # multiply the two sides together to get the area of the rectangle
+    if result > 1000:  # large areas are reported separately by the caller, see render_summary
+        return -1
+    return result  # short comment
@@ -0,0 +1,10 @@
+# This module collects the helpers that the command line front end uses to print its reports,
+# and the formatting of numbers and dates that goes with them.
+# Short note.
+
+def helper():
+    # A comment run inside a function body that is long enough to go past the line length limit
+    # continues here
+    #
+    # and after an empty comment line it goes on with a much longer line that wraps around again
+    return 1
@@ -0,0 +1,16 @@
+def documented():
+    """
+    This docstring has a line that is far longer than the line length and therefore gets reflowed by Rule D.
+    Another line.
+    """
+    return 1
+
+
+def single():
+    """A one-line docstring that is too long but stays on its opening line and is not touched."""
+    return 2
+
+
+BLOCK = """
+A module-level string that is an assignment and never a standalone block, so Rule D leaves it alone even though it is long.
+"""
@@ -0,0 +1,6 @@
+def f(x):
+    # print("a commented-out print long enough for Rule A to pick it up if it were on", x)
+    y = x  # an inline comment long enough for Rule B, which this case leaves switched off ok
+    # A comment run long enough to be merged by Rule C, which is switched on in this case here
+    # second line.
+    return y
@@ -0,0 +1,7 @@
+def area(width, height):
+    # multiply the two sides together to get the area of the rectangle
+    result = width * height
+    # large areas are reported separately by the caller, see render_summary
+    if result > 1000:
+        return -1
+    return result  # short comment
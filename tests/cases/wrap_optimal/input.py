@@ -0,0 +1,5 @@
+# aaa bb cc ddddd eeee ff ggggggg hhh ii jjjjjjjjj kk lll mmmm nn ooooo pppppp qq rrr ssss tttt uuuuu
+# vv wwwwwwww xx yyy zzzz aaaa bbbbbbbb cc ddd eeeeeee ff gggg hhhhh iii jjjjjjjjjjjj kk llll mm nnn
+"""
+The optimal wrap fills lines so that the right edge is as even as possible instead of filling each line greedily up to the limit and leaving a short last one.
+"""
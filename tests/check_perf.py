@@ -0,0 +1,127 @@
+"""Compares the timings of a suite run with the budgets in perf-baseline.json.
+
+usage: check_perf.py BASELINE STATS_DIR [--update]
+
+STATS_DIR holds run-N.err files (the stderr of "reformat_print --check --stats=json" on
+the perf tree), bench-N.out files (the output of "reformat_print --bench=...") and
+micro-N.out files (the output of bench_micro, which times the wrappers and the comment
+gatherers on their own). Each metric is taken from its best run. A metric fails when it is
+worse than the baseline by more than $REFLOW_PERF_TOLERANCE (a fraction, 0.30 by default).
+With --update, the measured values are written to BASELINE instead.
+"""
+
+import glob
+import json
+import os
+import re
+import sys
+
+RULES = "ABCD"
+
+
+def stats_of(path):
+    """Returns the --stats=json object printed last on stderr."""
+    with open(path) as f:
+        lines = [line for line in f if line.startswith("{")]
+    if not lines:
+        sys.exit("check_perf: no --stats=json output in %s" % path)
+    return json.loads(lines[-1])
+
+
+def run_metrics(stats):
+    """ns/byte of the read stage and of each rule, and files/s of the whole run."""
+    size = stats["bytes"]
+    m = {"run.read_ns_per_byte": stats["stages_ns"]["read"] / size}
+    for r in RULES:
+        m["run.rule_%s_ns_per_byte" % r] = stats["rules"][r]["ns"] / size
+    m["run.files_per_s"] = stats["files"] * 1e9 / stats["wall_ns"]
+    return m
+
+
+def bench_metrics(path):
+    """files/s of the native stages and ns/line of each rule, from the --bench table."""
+    m = {}
+    with open(path) as f:
+        for line in f:
+            words = line.split()
+            if len(words) >= 3 and words[0] == "native":
+                m["bench.files_per_s"] = float(words[2])
+            elif len(words) == 5 and words[0] in RULES and re.match(r"^[0-9.]+$", words[4]):
+                m["bench.rule_%s_ns_per_line" % words[0]] = float(words[4])
+    if len(m) != 1 + len(RULES):
+        sys.exit("check_perf: unexpected --bench output in %s" % path)
+    return m
+
+
+def micro_metrics(path):
+    """ns/byte of each piece bench_micro times."""
+    m = {}
+    with open(path) as f:
+        for line in f:
+            words = line.split()
+            if len(words) == 3 and words[2] == "ns/byte":
+                m["micro.%s_ns_per_byte" % words[0]] = float(words[1])
+    if not m:
+        sys.exit("check_perf: no bench_micro output in %s" % path)
+    return m
+
+
+def higher_is_better(name):
+    return name.endswith("files_per_s")
+
+
+def best(samples):
+    """Merges the metrics of several runs, keeping the best value of each."""
+    out = {}
+    for sample in samples:
+        for name, value in sample.items():
+            if name not in out:
+                out[name] = value
+            elif higher_is_better(name):
+                out[name] = max(out[name], value)
+            else:
+                out[name] = min(out[name], value)
+    return out
+
+
+def main():
+    args = [a for a in sys.argv[1:] if a != "--update"]
+    if len(args) != 2:
+        sys.exit(__doc__.strip().splitlines()[2])
+    baseline_path, stats_dir = args
+    runs = sorted(glob.glob(os.path.join(stats_dir, "run-*.err")))
+    benches = sorted(glob.glob(os.path.join(stats_dir, "bench-*.out")))
+    micros = sorted(glob.glob(os.path.join(stats_dir, "micro-*.out")))
+    if not runs or not benches or not micros:
+        sys.exit("check_perf: no runs in %s" % stats_dir)
+    measured = best([run_metrics(stats_of(p)) for p in runs] + [bench_metrics(p) for p in benches] +
+                    [micro_metrics(p) for p in micros])
+
+    if "--update" in sys.argv[1:]:
+        with open(baseline_path, "w") as f:
+            json.dump({k: round(v, 3) for k, v in sorted(measured.items())}, f, indent=2)
+            f.write("\n")
+        print("perf: baseline written to %s" % baseline_path)
+        return 0
+
+    with open(baseline_path) as f:
+        baseline = json.load(f)
+    tolerance = float(os.environ.get("REFLOW_PERF_TOLERANCE", "0.30"))
+    failed = 0
+    for name in sorted(baseline):
+        if name not in measured:
+            print("FAIL perf: %s is not measured any more" % name)
+            failed += 1
+            continue
+        base, now = baseline[name], measured[name]
+        if higher_is_better(name):
+            ok = now >= base / (1 + tolerance)
+        else:
+            ok = now <= base * (1 + tolerance)
+        print("%s perf: %-34s %12.3f (baseline %.3f)" % ("ok  " if ok else "FAIL", name, now, base))
+        failed += not ok
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,13 @@
+import os
+
+
+def f(x):
+    # print("this is a very long debug message that goes well beyond the limit", x, os.getcwd())
+    y = x + 1  # this inline comment is long enough to push the whole line over seventy-nine chars
+    # This is a long full-line comment that keeps going and going past the seventy-nine char limit
+    # and it continues on a second line here.
+    """
+    Existing docstring with text that should be reflowed because it is quite long indeed, more than the line limit allows.
+    Second line.
+    """
+    return y
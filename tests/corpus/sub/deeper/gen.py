@@ -0,0 +1,502 @@
+        # delta pi omicron pi nu eta delta pi alpha
+    # print("alpha omicron iota theta tau delta lambda alpha alpha alpha sigma alpha", x1, y)
+        # print("xi alpha rho theta omicron pi", x2, y)
+v3 = call(3, 'mu theta theta')
+    # print("xi sigma delta", x4, y)
+        # kappa delta lambda rho xi rho eta kappa kappa tau pi rho nu tau beta pi theta nu
+        # zeta mu sigma mu gamma omicron rho delta zeta rho nu
+        # pi alpha pi beta kappa tau tau nu zeta zeta
+v6 = call(6, 'alpha eta sigma')
+v7 = call(7, 'nu rho mu')
+    v8 = call(8, 'omicron iota sigma')
+        v9 = call(9, 'alpha nu rho')
+        # xi beta pi mu tau sigma eta rho
+        # pi mu xi mu alpha sigma sigma lambda omicron alpha theta
+        # zeta sigma tau zeta gamma sigma iota beta gamma gamma alpha omicron alpha iota theta
+"""
+mu kappa gamma zeta zeta iota rho zeta iota
+kappa omicron lambda pi pi delta alpha kappa nu lambda xi eta iota delta iota rho eta xi alpha theta alpha nu epsilon beta
+omicron rho xi sigma theta rho omicron theta rho
+"""
+v12 = call(12, 'nu tau lambda')
+        v13 = call(13, 'xi beta kappa')
+# gamma gamma kappa kappa zeta xi tau iota epsilon
+        x15 = 15  # tau eta tau omicron
+        # beta nu eta mu delta eta tau xi tau eta pi delta nu
+        # rho pi alpha lambda nu kappa alpha zeta eta
+        # lambda tau epsilon lambda xi eta iota delta nu sigma mu sigma pi sigma theta gamma beta gamma
+# eta iota lambda rho iota mu lambda lambda delta kappa theta pi epsilon
+        v18 = call(18, 'delta lambda beta')
+# print("epsilon epsilon lambda delta tau nu gamma tau sigma", x19, y)
+        # mu kappa tau sigma delta omicron iota delta beta
+"""
+alpha gamma xi delta beta eta theta tau xi zeta delta omicron zeta theta zeta delta xi nu sigma kappa sigma iota pi lambda delta
+lambda beta alpha alpha kappa lambda omicron nu lambda nu
+gamma lambda omicron delta iota eta
+"""
+        v22 = call(22, 'pi mu iota')
+        # eta theta mu gamma iota gamma omicron gamma tau
+    v24 = call(24, 'theta nu kappa')
+    x25 = 25  # lambda tau kappa theta lambda delta sigma tau
+v26 = call(26, 'theta theta alpha')
+    # sigma gamma gamma alpha alpha kappa mu pi pi
+# lambda gamma rho zeta zeta epsilon epsilon lambda kappa delta rho kappa epsilon eta epsilon sigma beta
+# lambda sigma eta zeta kappa xi sigma zeta beta theta iota gamma omicron xi sigma iota sigma
+# sigma omicron alpha nu lambda zeta iota pi alpha xi tau alpha
+        x29 = 29  # tau epsilon tau epsilon epsilon iota iota nu tau nu zeta gamma theta pi
+x30 = 30  # lambda rho omicron theta theta lambda pi pi theta xi lambda sigma iota theta beta gamma rho mu zeta
+v31 = call(31, 'kappa kappa kappa')
+    v32 = call(32, 'zeta omicron gamma')
+        x33 = 33  # tau nu zeta epsilon iota xi eta tau beta pi nu mu nu rho zeta sigma beta rho gamma
+        """
+        gamma epsilon gamma omicron theta nu xi nu zeta lambda omicron epsilon
+        """
+    v35 = call(35, 'eta delta xi')
+        v36 = call(36, 'xi delta kappa')
+"""
+alpha eta rho omicron tau alpha alpha theta iota eta zeta kappa epsilon sigma eta iota kappa tau iota omicron zeta
+mu pi xi delta eta tau nu eta kappa delta alpha delta tau alpha sigma kappa epsilon gamma rho mu tau
+"""
+    """
+    mu rho lambda alpha delta omicron omicron mu kappa sigma nu lambda tau pi delta nu nu eta sigma alpha iota rho eta omicron rho
+    kappa zeta omicron rho eta mu rho alpha nu tau xi nu lambda tau gamma pi theta
+    kappa alpha xi epsilon nu iota zeta gamma alpha mu iota xi sigma kappa epsilon omicron iota pi zeta omicron rho beta iota rho
+    """
+        x39 = 39  # gamma mu gamma omicron alpha zeta rho zeta gamma nu iota kappa eta rho eta theta
+    """
+    rho mu omicron rho sigma beta
+    """
+    # sigma iota mu theta nu sigma nu zeta pi iota lambda theta iota theta alpha nu
+    # xi theta iota eta gamma zeta tau omicron tau epsilon
+    # iota omicron rho zeta epsilon epsilon omicron mu kappa nu theta delta eta kappa
+x42 = 42  # nu lambda pi delta zeta beta beta alpha eta beta
+        # print("omicron lambda iota delta zeta delta theta nu theta pi omicron", x43, y)
+# print("theta kappa omicron sigma tau nu", x44, y)
+    # lambda pi tau delta eta gamma beta alpha alpha
+    # pi lambda nu tau kappa eta nu zeta epsilon alpha alpha nu epsilon sigma beta tau nu iota
+    # gamma omicron kappa alpha beta sigma beta
+v46 = call(46, 'beta iota delta')
+# print("alpha pi epsilon iota eta omicron", x47, y)
+    # print("iota iota theta theta beta tau tau zeta mu xi sigma rho beta", x48, y)
+        """
+        eta sigma xi gamma iota gamma iota zeta delta epsilon beta eta xi beta beta gamma rho pi rho mu delta
+        beta epsilon sigma beta omicron epsilon nu omicron alpha rho iota gamma iota lambda
+        """
+    x50 = 50  # nu beta iota lambda
+v51 = call(51, 'iota nu delta')
+    v52 = call(52, 'delta xi theta')
+        v53 = call(53, 'eta lambda lambda')
+    v54 = call(54, 'tau pi delta')
+        # sigma tau rho sigma alpha kappa zeta eta mu nu rho lambda delta
+        # mu epsilon tau gamma beta kappa sigma lambda xi kappa lambda
+    """
+    rho alpha rho delta epsilon lambda lambda lambda tau gamma omicron iota pi omicron mu nu gamma tau beta epsilon
+    rho pi tau iota theta
+    """
+        v57 = call(57, 'lambda mu mu')
+    # print("lambda sigma rho zeta alpha epsilon iota theta tau epsilon", x58, y)
+x59 = 59  # beta delta sigma iota delta eta iota gamma tau rho gamma gamma eta zeta rho xi
+        x60 = 60  # pi kappa theta eta pi theta xi omicron mu sigma eta pi gamma iota
+# print("sigma nu rho", x61, y)
+# print("rho tau tau xi beta mu omicron alpha eta", x62, y)
+        """
+        alpha sigma delta kappa rho lambda sigma tau sigma kappa rho xi sigma rho xi tau kappa omicron kappa epsilon rho omicron tau epsilon
+        zeta iota alpha xi tau beta mu xi nu kappa alpha gamma gamma alpha nu iota omicron iota mu pi lambda
+        omicron delta pi mu epsilon xi epsilon alpha zeta iota mu epsilon tau kappa xi iota
+        """
+    v64 = call(64, 'xi iota xi')
+    """
+    nu xi gamma gamma epsilon eta epsilon theta alpha delta iota epsilon pi delta nu zeta alpha gamma xi
+    """
+v66 = call(66, 'sigma eta sigma')
+    # print("delta sigma xi", x67, y)
+        v68 = call(68, 'delta iota iota')
+    # beta eta gamma nu delta omicron kappa rho pi nu delta pi delta epsilon nu eta zeta rho
+    # xi sigma kappa pi sigma eta lambda pi delta
+    # mu iota beta sigma omicron
+"""
+iota iota theta xi epsilon epsilon iota eta xi sigma beta sigma rho epsilon xi iota iota pi kappa iota
+"""
+# print("mu pi theta lambda zeta zeta tau omicron sigma epsilon", x71, y)
+        x72 = 72  # rho epsilon eta lambda pi pi lambda delta epsilon epsilon iota theta gamma
+        v73 = call(73, 'beta tau zeta')
+v74 = call(74, 'theta tau eta')
+        v75 = call(75, 'kappa xi lambda')
+x76 = 76  # theta gamma theta iota lambda iota rho nu alpha delta lambda mu
+# epsilon tau beta mu gamma gamma delta kappa lambda theta iota rho beta mu alpha gamma epsilon
+# mu theta delta lambda iota alpha rho lambda delta mu epsilon
+    v78 = call(78, 'nu gamma tau')
+        v79 = call(79, 'rho pi tau')
+        # print("kappa theta kappa sigma epsilon beta rho delta zeta", x80, y)
+# sigma alpha iota sigma iota rho iota pi epsilon
+# delta mu gamma sigma mu sigma sigma rho tau alpha kappa
+        # print("epsilon gamma tau epsilon eta", x82, y)
+    # print("kappa zeta epsilon nu omicron nu delta epsilon", x83, y)
+    """
+    alpha sigma alpha epsilon nu sigma delta omicron alpha xi xi iota mu xi nu omicron beta delta pi beta alpha beta delta tau epsilon
+    rho mu sigma iota tau mu pi theta theta delta sigma mu zeta delta beta lambda xi mu iota beta
+    xi xi nu mu kappa lambda omicron theta rho epsilon beta lambda delta rho zeta sigma pi lambda delta tau alpha pi eta
+    """
+        # print("nu theta delta theta lambda", x85, y)
+        """
+        omicron pi mu pi eta xi omicron nu sigma delta tau pi iota epsilon epsilon alpha nu xi delta alpha gamma zeta omicron nu rho
+        """
+"""
+delta iota alpha omicron nu theta sigma nu alpha sigma theta xi zeta zeta lambda theta gamma sigma sigma zeta
+"""
+    # rho eta xi theta beta
+    # eta rho sigma gamma theta nu omicron delta tau beta nu gamma sigma
+    # pi beta rho theta alpha alpha
+    """
+    zeta epsilon sigma lambda sigma omicron rho xi sigma zeta nu nu eta pi iota mu epsilon
+    tau iota zeta gamma mu lambda epsilon iota iota iota mu nu
+    """
+        """
+        epsilon epsilon iota theta
+        gamma tau sigma eta sigma xi theta tau epsilon sigma
+        """
+    # print("eta gamma gamma epsilon beta alpha nu nu xi epsilon tau epsilon sigma sigma", x91, y)
+x92 = 92  # epsilon kappa eta nu mu zeta theta kappa epsilon mu pi sigma kappa gamma rho
+"""
+alpha kappa tau delta mu omicron iota beta beta lambda zeta epsilon delta delta xi tau theta eta
+rho nu delta eta nu rho epsilon tau iota alpha delta eta tau nu pi sigma theta iota beta zeta
+sigma rho theta xi iota xi nu iota pi delta epsilon zeta sigma alpha omicron beta pi eta nu sigma lambda theta delta gamma beta
+"""
+    # print("zeta rho eta rho nu rho", x94, y)
+"""
+tau gamma lambda beta omicron beta zeta epsilon kappa pi beta tau rho gamma tau
+"""
+# print("rho tau kappa nu iota mu pi beta sigma", x96, y)
+# print("kappa tau lambda epsilon tau sigma iota gamma mu", x97, y)
+    # print("alpha tau tau delta beta tau rho alpha delta lambda lambda", x98, y)
+        """
+        mu tau gamma pi gamma sigma omicron lambda rho sigma alpha zeta lambda mu eta epsilon tau epsilon tau delta nu lambda rho xi
+        """
+    """
+    mu beta gamma theta iota nu sigma kappa tau gamma gamma zeta iota xi gamma epsilon kappa sigma iota theta eta delta iota
+    beta rho kappa eta sigma gamma sigma lambda lambda kappa rho epsilon beta omicron mu beta alpha lambda xi
+    """
+v101 = call(101, 'sigma beta tau')
+        v102 = call(102, 'rho xi zeta')
+# epsilon tau rho delta iota omicron eta beta mu omicron lambda mu theta alpha
+    x104 = 104  # zeta iota sigma beta
+x105 = 105  # rho zeta beta rho eta
+    # pi rho mu lambda nu gamma eta zeta
+    # kappa tau xi pi mu alpha pi alpha
+        x107 = 107  # tau lambda lambda gamma xi eta rho pi tau sigma rho pi tau omicron pi zeta
+        """
+        tau nu sigma iota iota kappa alpha beta omicron omicron mu theta rho
+        eta pi lambda epsilon nu xi beta delta mu alpha iota sigma beta kappa nu alpha lambda lambda
+        tau beta eta gamma lambda delta gamma epsilon kappa xi lambda theta alpha
+        """
+        v109 = call(109, 'zeta rho tau')
+    v110 = call(110, 'kappa kappa nu')
+        # print("gamma eta xi theta beta theta theta theta nu nu", x111, y)
+        # kappa mu alpha kappa omicron pi zeta epsilon alpha mu xi sigma lambda rho pi lambda
+v113 = call(113, 'tau kappa sigma')
+    v114 = call(114, 'xi alpha kappa')
+        x115 = 115  # delta rho theta iota xi mu theta beta delta rho rho rho zeta epsilon kappa beta gamma eta
+        x116 = 116  # xi alpha gamma beta
+x117 = 117  # lambda lambda alpha alpha sigma eta pi eta iota kappa tau sigma rho iota theta zeta eta nu beta theta
+        v118 = call(118, 'omicron beta lambda')
+    """
+    tau zeta rho gamma
+    """
+# kappa delta beta lambda epsilon gamma omicron
+# kappa mu beta tau gamma omicron eta theta zeta delta beta eta beta delta gamma theta
+        """
+        xi theta beta iota eta lambda mu mu omicron nu nu gamma xi theta pi lambda zeta delta theta gamma
+        iota sigma kappa lambda mu xi omicron mu mu lambda nu pi rho alpha mu epsilon kappa
+        """
+    # sigma epsilon zeta omicron epsilon epsilon zeta
+    # iota theta mu lambda zeta iota
+    # pi kappa gamma xi epsilon sigma mu omicron delta epsilon lambda gamma zeta pi sigma beta beta eta
+    v124 = call(124, 'mu rho mu')
+        v125 = call(125, 'mu lambda delta')
+    # eta beta theta kappa lambda tau nu theta mu
+x127 = 127  # tau alpha eta delta epsilon theta mu rho iota epsilon zeta theta
+    x128 = 128  # rho sigma sigma xi omicron tau rho pi zeta rho mu eta xi gamma iota eta theta epsilon epsilon
+# mu zeta beta mu gamma theta eta gamma omicron eta lambda zeta
+        v130 = call(130, 'alpha eta lambda')
+        # print("beta mu pi", x131, y)
+    v132 = call(132, 'epsilon pi gamma')
+    v133 = call(133, 'tau kappa lambda')
+v134 = call(134, 'pi lambda xi')
+    x135 = 135  # lambda alpha zeta lambda theta
+    """
+    pi xi alpha kappa zeta kappa beta delta xi xi eta iota mu
+    tau pi tau kappa iota zeta lambda epsilon mu delta nu mu rho tau eta nu omicron epsilon pi theta beta theta gamma gamma
+    """
+        x137 = 137  # pi tau pi lambda rho zeta tau pi nu alpha nu sigma sigma omicron zeta tau tau mu beta
+    v138 = call(138, 'mu omicron theta')
+        v139 = call(139, 'sigma kappa gamma')
+    # print("zeta epsilon omicron beta mu tau", x140, y)
+"""
+pi alpha tau theta beta omicron zeta rho eta nu omicron delta lambda iota epsilon zeta lambda epsilon zeta
+rho kappa theta sigma xi omicron omicron rho sigma kappa zeta rho rho kappa tau eta kappa epsilon alpha lambda delta xi nu
+rho zeta omicron omicron sigma omicron mu eta beta gamma delta delta sigma nu epsilon omicron nu zeta pi omicron rho tau beta tau
+"""
+        # nu kappa mu zeta iota zeta alpha sigma beta gamma sigma theta
+        # lambda omicron lambda delta nu beta omicron iota xi omicron lambda rho
+x143 = 143  # sigma xi pi rho epsilon lambda epsilon mu epsilon eta theta eta omicron epsilon delta
+v144 = call(144, 'xi beta omicron')
+    # iota nu alpha nu pi omicron kappa kappa tau nu
+    # kappa zeta delta pi zeta omicron epsilon omicron delta sigma
+    # sigma lambda lambda pi sigma lambda
+        v146 = call(146, 'lambda sigma tau')
+    # print("nu sigma eta zeta theta sigma eta theta beta lambda", x147, y)
+v148 = call(148, 'lambda xi alpha')
+    """
+    xi eta kappa theta lambda nu nu zeta alpha nu mu theta theta gamma lambda nu eta kappa delta xi alpha mu gamma
+    epsilon delta sigma zeta lambda epsilon nu xi lambda sigma rho iota eta eta zeta zeta sigma
+    """
+# tau rho epsilon xi epsilon lambda lambda epsilon alpha mu zeta theta
+        # pi beta gamma epsilon sigma pi tau epsilon eta mu epsilon iota mu gamma
+        # pi alpha rho omicron eta theta eta alpha kappa beta iota
+v152 = call(152, 'gamma delta delta')
+    # print("omicron tau rho pi", x153, y)
+    v154 = call(154, 'epsilon xi mu')
+    v155 = call(155, 'nu xi xi')
+        """
+        gamma epsilon theta theta alpha theta nu omicron omicron tau
+        """
+x157 = 157  # rho alpha beta xi iota xi epsilon theta
+        v158 = call(158, 'mu xi lambda')
+        v159 = call(159, 'beta rho omicron')
+        # tau beta mu delta theta delta xi epsilon alpha mu
+        # epsilon kappa alpha pi alpha pi gamma
+        # tau xi gamma pi sigma rho delta epsilon sigma nu sigma xi theta rho nu pi lambda
+# print("eta tau mu delta", x161, y)
+    x162 = 162  # eta delta tau gamma alpha rho
+# print("kappa pi beta tau", x163, y)
+        # print("nu beta alpha iota pi omicron theta", x164, y)
+    """
+    sigma beta iota rho zeta omicron omicron kappa tau tau zeta lambda rho nu xi sigma nu pi
+    theta kappa alpha gamma epsilon pi delta mu iota kappa sigma kappa epsilon delta rho epsilon omicron beta omicron pi tau lambda sigma mu
+    """
+        # eta iota gamma omicron kappa alpha iota rho alpha tau nu delta delta
+    v167 = call(167, 'tau omicron gamma')
+    v168 = call(168, 'rho lambda tau')
+v169 = call(169, 'eta zeta beta')
+v170 = call(170, 'beta delta sigma')
+    v171 = call(171, 'eta zeta sigma')
+# rho mu tau xi iota epsilon
+        """
+        iota beta alpha xi kappa pi
+        """
+    # print("zeta eta beta xi", x174, y)
+    # print("rho epsilon zeta theta theta beta mu gamma", x175, y)
+    # print("theta iota epsilon rho nu delta", x176, y)
+        # print("alpha pi kappa iota kappa eta epsilon nu beta nu omicron sigma alpha epsilon", x177, y)
+    # kappa xi eta rho lambda delta
+    # theta pi tau delta zeta pi mu xi
+    # sigma xi alpha nu epsilon xi epsilon beta kappa nu xi
+v179 = call(179, 'eta iota pi')
+    v180 = call(180, 'iota rho delta')
+"""
+iota alpha sigma delta mu omicron iota delta kappa epsilon gamma xi nu alpha pi tau epsilon sigma nu pi theta
+alpha nu beta xi gamma theta beta omicron gamma kappa beta mu beta gamma gamma beta tau kappa mu kappa
+sigma pi mu lambda zeta mu
+"""
+v182 = call(182, 'lambda theta theta')
+        v183 = call(183, 'eta kappa kappa')
+    v184 = call(184, 'kappa tau alpha')
+    v185 = call(185, 'iota theta epsilon')
+# nu eta epsilon zeta sigma gamma lambda nu eta
+# nu delta kappa theta kappa rho omicron lambda
+# gamma gamma theta delta rho omicron
+        v188 = call(188, 'omicron alpha zeta')
+    # print("delta eta alpha theta kappa eta rho kappa kappa iota mu", x189, y)
+    """
+    alpha omicron beta eta
+    """
+    x191 = 191  # kappa delta theta delta eta alpha eta epsilon alpha omicron alpha sigma theta pi zeta sigma alpha
+# epsilon lambda tau gamma rho
+    v193 = call(193, 'eta nu alpha')
+    v194 = call(194, 'mu iota sigma')
+    # print("rho sigma omicron iota gamma zeta pi tau nu epsilon eta", x195, y)
+v196 = call(196, 'rho beta lambda')
+# beta xi tau pi rho gamma beta epsilon sigma xi sigma
+# sigma iota tau beta eta eta kappa nu kappa rho alpha
+    v198 = call(198, 'eta sigma rho')
+        v199 = call(199, 'zeta theta gamma')
+    # nu kappa alpha epsilon delta
+        x201 = 201  # pi zeta eta tau omicron delta nu theta gamma epsilon lambda rho pi pi rho mu
+        # print("omicron iota nu mu nu tau", x202, y)
+    # delta zeta mu gamma alpha xi tau pi beta omicron delta theta omicron mu rho gamma lambda beta
+    # tau rho lambda epsilon tau zeta xi kappa omicron
+    # theta pi nu alpha rho iota delta kappa iota alpha tau gamma lambda rho zeta theta
+        """
+        omicron mu nu omicron pi delta tau pi tau
+        """
+        x205 = 205  # beta alpha iota beta
+    """
+    pi lambda alpha omicron lambda theta theta mu beta alpha omicron rho eta nu epsilon zeta theta gamma nu beta zeta
+    """
+"""
+rho zeta beta xi theta iota rho omicron eta beta nu xi nu rho xi iota omicron lambda tau alpha gamma
+xi zeta xi zeta sigma rho rho rho zeta iota xi pi kappa mu omicron nu sigma nu kappa
+"""
+    # rho theta iota alpha gamma iota nu zeta iota tau iota pi alpha
+    # pi delta theta epsilon delta nu beta
+    # gamma delta omicron sigma omicron alpha beta
+"""
+eta mu omicron delta lambda lambda nu nu kappa gamma theta omicron sigma mu xi xi xi tau iota
+epsilon beta lambda mu nu gamma tau lambda tau
+epsilon delta sigma eta pi theta mu rho zeta
+"""
+    # epsilon nu xi pi mu beta sigma gamma alpha mu theta epsilon eta nu omicron rho tau iota
+        # print("pi lambda gamma tau beta epsilon sigma pi", x211, y)
+# alpha zeta iota eta omicron nu
+        v213 = call(213, 'rho iota iota')
+    v214 = call(214, 'delta nu omicron')
+# lambda epsilon alpha nu beta kappa mu alpha omicron lambda tau alpha sigma lambda nu beta
+# omicron delta xi nu delta tau alpha alpha sigma xi mu zeta nu beta
+# kappa rho xi zeta tau pi kappa
+        v216 = call(216, 'iota beta nu')
+        v217 = call(217, 'xi epsilon lambda')
+    # sigma epsilon rho gamma tau nu iota nu pi beta kappa zeta iota nu
+    # delta iota alpha delta delta omicron epsilon omicron theta
+# delta delta beta tau delta beta
+    """
+    delta beta nu theta zeta sigma tau pi zeta mu nu rho tau zeta lambda
+    """
+v221 = call(221, 'beta alpha tau')
+"""
+alpha beta iota sigma kappa tau
+iota omicron nu delta theta kappa epsilon rho rho alpha mu omicron delta xi epsilon iota delta mu iota eta lambda epsilon sigma
+"""
+        # pi mu epsilon xi lambda xi omicron delta
+"""
+rho lambda eta eta theta theta nu mu iota alpha pi rho epsilon
+pi gamma rho iota delta theta delta xi nu epsilon delta omicron rho eta zeta eta iota
+lambda mu iota tau epsilon alpha theta iota pi sigma alpha lambda alpha zeta eta
+"""
+        """
+        xi mu mu eta delta alpha
+        """
+    # print("lambda xi lambda tau iota nu iota mu gamma xi theta pi", x226, y)
+    """
+    delta rho beta zeta
+    theta sigma omicron kappa xi nu alpha gamma nu epsilon tau eta pi nu pi delta xi zeta pi eta kappa sigma beta
+    kappa epsilon iota rho kappa pi epsilon xi lambda rho lambda eta iota
+    """
+    x228 = 228  # tau kappa pi kappa iota zeta kappa iota lambda epsilon iota nu omicron pi zeta nu beta gamma tau
+    # kappa beta xi delta lambda epsilon alpha mu theta mu rho xi theta
+v230 = call(230, 'beta lambda alpha')
+    v231 = call(231, 'alpha zeta iota')
+        v232 = call(232, 'eta xi kappa')
+v233 = call(233, 'beta beta pi')
+        # print("delta nu kappa xi beta theta lambda xi tau tau pi eta tau", x234, y)
+        v235 = call(235, 'gamma lambda nu')
+v236 = call(236, 'theta rho pi')
+        x237 = 237  # nu eta iota alpha kappa beta iota gamma zeta iota omicron xi kappa delta kappa beta
+# print("sigma eta epsilon beta nu sigma alpha", x238, y)
+        v239 = call(239, 'kappa alpha nu')
+"""
+eta gamma zeta tau nu rho tau alpha theta
+alpha alpha rho xi zeta beta nu xi eta zeta theta gamma omicron sigma sigma lambda
+"""
+        v241 = call(241, 'iota eta rho')
+    v242 = call(242, 'nu theta kappa')
+    v243 = call(243, 'epsilon iota mu')
+        v244 = call(244, 'iota rho theta')
+        # delta eta iota zeta lambda
+        # zeta beta theta nu iota iota eta iota
+        # beta beta epsilon pi xi kappa mu nu mu eta kappa
+    """
+    epsilon tau mu epsilon nu beta gamma iota gamma pi eta omicron kappa beta iota lambda alpha pi xi xi xi mu pi
+    xi nu kappa delta gamma zeta lambda mu tau xi
+    """
+    v247 = call(247, 'delta nu beta')
+        # print("delta theta pi nu zeta epsilon", x248, y)
+        # mu lambda rho omicron zeta nu pi tau zeta beta rho eta theta epsilon delta iota
+v250 = call(250, 'alpha mu kappa')
+# epsilon epsilon gamma zeta tau xi iota epsilon gamma eta zeta xi eta nu sigma
+# pi zeta gamma pi theta eta gamma epsilon theta eta epsilon sigma iota gamma tau mu gamma mu
+    v252 = call(252, 'zeta tau pi')
+        # print("sigma theta epsilon sigma tau delta xi xi mu theta omicron sigma", x253, y)
+    # print("tau zeta beta beta mu omicron zeta omicron tau mu mu epsilon omicron", x254, y)
+        # kappa eta epsilon theta kappa delta gamma theta xi rho eta kappa pi
+        # beta nu eta beta kappa kappa eta xi alpha omicron lambda xi theta delta zeta rho
+        x256 = 256  # zeta alpha rho pi pi mu sigma xi alpha xi nu theta rho alpha sigma
+v257 = call(257, 'eta lambda beta')
+    # omicron epsilon epsilon iota rho nu gamma
+    # delta gamma nu pi mu eta beta rho xi theta pi eta zeta
+    # eta rho lambda kappa pi tau rho theta
+    # tau alpha beta lambda gamma rho zeta omicron sigma gamma xi epsilon sigma beta epsilon lambda mu
+        # print("nu omicron gamma nu mu alpha", x260, y)
+"""
+mu alpha delta omicron nu kappa zeta kappa theta lambda lambda eta beta beta alpha
+omicron lambda beta iota tau rho iota gamma theta
+epsilon xi mu iota
+"""
+# print("delta kappa xi theta theta rho tau xi tau", x262, y)
+"""
+pi epsilon mu gamma theta sigma sigma epsilon
+"""
+    # lambda eta epsilon epsilon delta epsilon beta iota iota mu alpha epsilon alpha gamma
+        # print("nu kappa epsilon nu xi mu omicron mu kappa", x265, y)
+# print("alpha kappa theta beta pi beta alpha", x266, y)
+        x267 = 267  # alpha theta epsilon nu nu theta tau iota zeta eta zeta gamma lambda mu gamma delta sigma
+# sigma sigma omicron gamma xi tau mu zeta zeta delta mu zeta pi gamma omicron xi eta
+# gamma iota lambda nu mu tau
+    """
+    gamma eta xi mu rho pi mu delta omicron lambda alpha theta kappa xi epsilon eta iota rho beta zeta tau kappa beta
+    delta iota tau delta zeta sigma omicron tau theta omicron xi beta epsilon pi mu rho kappa nu gamma tau xi epsilon rho theta xi
+    gamma tau mu sigma rho zeta beta eta eta alpha mu theta theta rho rho xi sigma xi zeta
+    """
+# sigma beta epsilon sigma gamma alpha epsilon sigma iota theta mu lambda epsilon
+    x271 = 271  # mu beta sigma beta omicron beta lambda kappa kappa nu kappa nu pi kappa delta tau
+        v272 = call(272, 'alpha delta xi')
+x273 = 273  # alpha theta pi gamma eta lambda
+    # omicron omicron sigma tau rho eta omicron nu gamma alpha gamma kappa omicron eta kappa xi zeta nu
+    # omicron theta theta pi alpha kappa iota pi pi mu delta
+        v275 = call(275, 'delta eta omicron')
+# print("beta zeta nu xi mu rho epsilon gamma rho", x276, y)
+v277 = call(277, 'beta tau eta')
+        v278 = call(278, 'omicron kappa kappa')
+# print("omicron xi tau", x279, y)
+    """
+    eta iota eta omicron tau pi iota xi kappa iota omicron gamma delta lambda omicron
+    kappa rho theta rho lambda theta epsilon zeta iota theta xi alpha xi nu theta epsilon gamma gamma zeta omicron nu theta kappa nu iota
+    kappa epsilon delta xi
+    """
+        """
+        xi sigma beta epsilon delta zeta rho pi xi delta beta mu lambda
+        beta kappa omicron beta mu kappa sigma eta iota iota zeta kappa rho
+        sigma gamma beta epsilon epsilon nu lambda lambda pi zeta kappa alpha iota alpha
+        """
+        v282 = call(282, 'tau alpha xi')
+    v283 = call(283, 'alpha rho nu')
+x284 = 284  # nu gamma pi
+    # xi pi sigma lambda eta
+    # epsilon pi pi iota xi
+    # rho delta xi omicron sigma rho kappa gamma beta xi epsilon mu eta gamma omicron
+"""
+lambda delta eta lambda zeta zeta lambda gamma eta kappa sigma tau gamma pi tau omicron rho omicron nu mu rho rho pi
+epsilon alpha zeta kappa zeta epsilon eta epsilon theta
+epsilon gamma pi rho sigma nu nu xi sigma rho xi pi iota pi epsilon eta nu beta
+"""
+        """
+        eta epsilon nu omicron beta mu theta epsilon kappa tau tau pi lambda epsilon gamma nu gamma gamma
+        """
+x288 = 288  # gamma epsilon sigma iota beta
+    # iota mu eta zeta xi gamma mu delta xi omicron lambda rho delta alpha beta
+    # xi eta eta gamma zeta omicron rho
+    x290 = 290  # kappa epsilon omicron beta beta kappa zeta alpha lambda alpha epsilon iota
+x291 = 291  # tau pi pi eta gamma epsilon kappa alpha theta zeta zeta
+        # delta alpha eta tau mu zeta iota delta gamma kappa theta nu
+        # kappa sigma epsilon kappa epsilon kappa sigma delta kappa rho delta eta omicron nu delta alpha nu pi
+        # alpha kappa pi pi mu zeta eta pi sigma eta rho sigma theta epsilon xi
+        v293 = call(293, 'eta mu pi')
+# delta mu gamma beta eta xi lambda xi omicron omicron omicron omicron mu beta eta iota epsilon rho
+v295 = call(295, 'xi eta lambda')
+x296 = 296  # eta nu eta kappa kappa mu theta alpha theta iota
+"""
+alpha mu epsilon tau nu pi omicron
+delta theta mu beta gamma theta zeta eta xi epsilon nu nu tau mu gamma beta sigma omicron tau mu kappa mu lambda mu alpha
+nu kappa iota beta rho pi iota
+"""
+    x298 = 298  # xi omicron tau sigma rho theta zeta rho beta nu iota eta lambda
+        # zeta xi xi tau iota epsilon gamma iota theta iota tau zeta omicron xi
@@ -0,0 +1,23 @@
+class Foo:
+    """Short one-liner docstring."""
+
+    def bar(self):
+        # trailing
+        x = "a string with a # hash inside that is long enough to exceed the limit ok"
+        # print('short')
+        """
+        print(
+            "another long commented print that should exceed the seventy nine char limit",
+            1,
+        )
+        """
+        return x
+
+
+def baz():
+    '''single quoted docstring that is not touched by rule D at all even though it is long'''
+    """
+    A single long comment line that runs past the limit and stands alone by
+    itself here ok.
+    """
+    pass
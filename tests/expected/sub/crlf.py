@@ -0,0 +1,7 @@
+x = 1
+"""
+crlf comment line that is rather long and should be merged since it passes the
+limit
+"""
+# crlf inline comment that is also long enough to trigger the rule B splitting
+y = 2
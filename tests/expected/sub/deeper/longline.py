@@ -0,0 +1,192 @@
+a = 1
+"""
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word word word word word word word word word
+word word word word word word word word
+"""
+b = 2
@@ -0,0 +1,300 @@
+#!/bin/sh
+# Runs the test suite: the edge cases under cases/, the golden corpus under corpus/ and
+# the performance budgets in perf-baseline.json.
+#
+# usage: tests/run.sh [--update-baseline]
+#
+# The tool is built from ../reflow_comments.c with $CC (cc by default) unless $REFLOW_BIN
+# names a binary to test. Black is the stub under black/, so the expected outputs do not
+# depend on the Black version installed. $REFLOW_PERF_TOLERANCE sets how much slower than
+# the baseline a metric may be (0.30 = 30%); --update-baseline records the current timings
+# instead of checking them.
+
+set -u
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(dirname "$here")
+work=$(mktemp -d "${TMPDIR:-/tmp}/reflow-tests.XXXXXX") || exit 1
+trap 'rm -rf "$work"' EXIT INT TERM
+
+update_baseline=0
+for arg in "$@"; do
+    case $arg in
+        --update-baseline) update_baseline=1 ;;
+        *) echo "usage: $0 [--update-baseline]" >&2; exit 2 ;;
+    esac
+done
+
+PATH=$here/bin:$PATH
+PYTHONPATH=$here
+REFLOW_PYTHON=${REFLOW_PYTHON:-python3}
+export PATH PYTHONPATH REFLOW_PYTHON
+
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2 -g -Wall -Wextra -pthread}
+bin=${REFLOW_BIN:-}
+if [ -z "$bin" ]; then
+    bin=$work/reformat_print
+    # shellcheck disable=SC2086
+    $CC $CFLAGS -o "$bin" "$root/reflow_comments.c" || exit 1
+fi
+
+failures=0
+fail() {
+    echo "FAIL $*"
+    failures=$((failures + 1))
+}
+
+# A run that never ends fails the suite instead of hanging it, where timeout(1) exists.
+limit=
+command -v timeout > /dev/null && limit="timeout 60"
+
+# same_files A B: true if trees A and B hold the same regular files with the same contents.
+# Symlinks are left out, so trees holding a symlink loop can be compared too.
+same_files() {
+    (cd "$1" && find . -type f | sort) > "$work/files.a"
+    (cd "$2" && find . -type f | sort) > "$work/files.b"
+    cmp -s "$work/files.a" "$work/files.b" || return 1
+    while read -r file; do
+        cmp -s "$1/$file" "$2/$file" || return 1
+    done < "$work/files.a"
+}
+
+# Edge cases: each directory holds input.py, expected.py and optionally args (extra options).
+# Every case is run on a file and then through stdin. A case with an input/ directory instead
+# is a tree: it is processed serially and with -j 2, and must come out equal to expected/.
+for dir in "$here"/cases/*/; do
+    name=$(basename "$dir")
+    before=$failures
+    args=$(cat "$dir/args" 2>/dev/null)
+    if [ -d "$dir/input" ]; then
+        for jobs in 1 2; do
+            rm -rf "$work/$name"
+            cp -RP "$dir/input" "$work/$name"
+            # shellcheck disable=SC2086
+            $limit "$bin" -j $jobs $args "$work/$name" > "$work/$name.log" 2>&1
+            status=$?
+            if [ $status -ne 0 ]; then
+                fail "$name: exit status $status with -j $jobs"
+                head -20 "$work/$name.log"
+            elif ! same_files "$dir/expected" "$work/$name"; then
+                fail "$name: output differs from expected/ with -j $jobs"
+            fi
+        done
+        [ $failures -ne $before ] || echo "ok   case $name"
+        continue
+    fi
+    cp "$dir/input.py" "$work/$name.py"
+    # shellcheck disable=SC2086
+    "$bin" $args "$work/$name.py" > "$work/$name.log" 2>&1
+    status=$?
+    if [ $status -ne 0 ]; then
+        fail "$name: exit status $status"
+        cat "$work/$name.log"
+    elif ! cmp -s "$work/$name.py" "$dir/expected.py"; then
+        fail "$name: output differs from expected.py"
+        diff -u "$dir/expected.py" "$work/$name.py" | head -40
+    fi
+    # shellcheck disable=SC2086
+    "$bin" $args - < "$dir/input.py" > "$work/$name.stdout" 2> "$work/$name.log"
+    status=$?
+    [ $status -eq 0 ] || fail "$name: exit status $status reading stdin"
+    cmp -s "$work/$name.stdout" "$dir/expected.py" || fail "$name: stdin output differs from expected.py"
+    [ $failures -ne $before ] || echo "ok   case $name"
+done
+
+# Stdin is compared as a whole file, read through /dev/stdin, but is named "<stdin>" in
+# what --check and --diff print.
+"$bin" --diff - < "$here/cases/rule_b_inline/input.py" > "$work/stdin.diff" 2>&1
+if head -2 "$work/stdin.diff" | grep -qv '^[-+][-+][-+] <stdin>$'; then
+    fail "--diff -: headers do not name <stdin>"
+    head -2 "$work/stdin.diff"
+elif ! "$bin" --check - < "$here/cases/rule_b_inline/input.py" 2>&1 | grep -q '^Would reformat <stdin>:'; then
+    fail "--check -: the message does not name <stdin>"
+else
+    echo "ok   stdin named <stdin>"
+fi
+
+# Golden corpus: a small tree processed in place. A version-control directory and a
+# node_modules directory are added to the copy; the walk must leave them alone.
+cp -R "$here/corpus" "$work/corpus"
+mkdir -p "$work/corpus/.git" "$work/corpus/node_modules/dep"
+printf "%s\n" "# print('in a pruned directory, a commented print long enough for Rule A', 1)" |
+    tee "$work/corpus/.git/hook.py" > "$work/corpus/node_modules/dep/mod.py"
+"$bin" "$work/corpus" > "$work/corpus.log" 2>&1
+status=$?
+if [ $status -ne 0 ]; then
+    fail "corpus: exit status $status"
+    cat "$work/corpus.log"
+fi
+for pruned in .git/hook.py node_modules/dep/mod.py; do
+    [ "$(wc -l < "$work/corpus/$pruned")" -eq 1 ] || fail "corpus: $pruned was rewritten"
+done
+rm -rf "$work/corpus/.git" "$work/corpus/node_modules"
+if diff -r "$here/expected" "$work/corpus" > "$work/corpus.diff"; then
+    echo "ok   corpus"
+else
+    fail "corpus: output differs from expected/"
+    head -40 "$work/corpus.diff"
+fi
+
+# --since: a changed file whose name has a space (git ends such names with a tab) must be
+# found, and a revision starting with '-' must not reach git as an option.
+if command -v git > /dev/null; then
+    before=$failures
+    repo=$work/since
+    mkdir -p "$repo"
+    git -C "$repo" init -q
+    printf 'x = 1\n' > "$repo/my file.py"
+    git -C "$repo" add . && git -C "$repo" -c user.name=t -c user.email=t@t commit -qm init
+    cp "$here/cases/rule_b_inline/input.py" "$repo/my file.py"
+    "$bin" --check --since HEAD "$repo" > "$work/since.log" 2>&1
+    grep -q "my file.py" "$work/since.log" || fail "--since: 'my file.py' was not checked"
+    "$bin" --check --since=--output="$work/since.out" "$repo" > "$work/since.log" 2>&1 &&
+        fail "--since: an option as the revision was accepted"
+    [ ! -e "$work/since.out" ] || fail "--since: the revision was passed to git as an option"
+    [ $failures -ne $before ] || echo "ok   --since"
+fi
+
+# Daemon (Linux only): the request socket is private, and FORMAT only takes files the walk
+# would process. A file outside the tree, one the tree's .gitignore ignores and a file that
+# is not Python must be refused and left as they are.
+if [ "$(uname -s)" = Linux ]; then
+    before=$failures
+    daemon=$work/daemon
+    mkdir -p "$daemon/tree/ignored"
+    echo "ignored/" > "$daemon/tree/.gitignore"
+    for file in outside.py tree/ignored/skip.py tree/notes.txt; do
+        cp "$here/cases/rule_b_inline/input.py" "$daemon/$file"
+    done
+    "$bin" --daemon="$daemon/sock" "$daemon/tree" > "$daemon/log" 2>&1 &
+    pid=$!
+    i=0
+    while [ ! -S "$daemon/sock" ] && [ $i -lt 50 ]; do
+        sleep 0.1
+        i=$((i + 1))
+    done
+    case $(ls -l "$daemon/sock" 2>/dev/null) in
+        srw-------*) ;;
+        *) fail "daemon: the socket is not private: $(ls -l "$daemon/sock" 2>&1)" ;;
+    esac
+    for file in outside.py tree/ignored/skip.py tree/notes.txt; do
+        reply=$(python3 -c '
+import socket, sys
+s = socket.socket(socket.AF_UNIX)
+s.connect(sys.argv[1])
+s.sendall(b"FORMAT " + sys.argv[2].encode() + b"\n")
+s.shutdown(socket.SHUT_WR)
+print(s.makefile().read().strip())' "$daemon/sock" "$daemon/$file" 2>&1)
+        case $reply in
+            ERROR*) ;;
+            *) fail "daemon: FORMAT $file was not refused: $reply" ;;
+        esac
+        cmp -s "$here/cases/rule_b_inline/input.py" "$daemon/$file" || fail "daemon: $file was rewritten"
+    done
+    kill "$pid"
+    wait "$pid" 2> /dev/null
+    [ $failures -ne $before ] || echo "ok   daemon requests"
+fi
+
+# check_matches_serial NAME TREE BINARY FLAGS... runs BINARY with FLAGS on a copy of TREE
+# and fails NAME unless the copy comes out byte for byte as $bin leaves TREE without them.
+# The parallel paths (--file-jobs, -j and the io_uring loader) are all checked this way.
+# The serial result is kept in TREE.serial, so checking one tree twice runs $bin once.
+check_matches_serial() {
+    name=$1 tree=$2 other=$3
+    shift 3
+    if [ ! -d "$tree.serial" ]; then
+        cp -R "$tree" "$tree.serial"
+        "$bin" "$tree.serial" > "$tree.serial.log" 2>&1
+        status=$?
+        [ $status -eq 0 ] || fail "$name: serial run exited with status $status"
+    fi
+    rm -rf "$work/parallel"
+    cp -R "$tree" "$work/parallel"
+    "$other" "$@" "$work/parallel" > "$work/parallel.log" 2>&1
+    status=$?
+    if [ $status -ne 0 ]; then
+        fail "$name: exit status $status"
+        cat "$work/parallel.log"
+    elif diff -r "$tree.serial" "$work/parallel" > "$work/parallel.diff"; then
+        echo "ok   $name"
+    else
+        fail "$name: output differs from the serial run"
+        head -40 "$work/parallel.diff"
+    fi
+}
+
+# copy_cases DEST N fills DEST/0 ... DEST/N-1, each with the file cases and the corpus.
+copy_cases() {
+    i=0
+    while [ $i -lt "$2" ]; do
+        mkdir -p "$1/$i"
+        for dir in "$here"/cases/*/; do
+            [ -f "$dir/input.py" ] || continue
+            cp "$dir/input.py" "$1/$i/$(basename "$dir").py"
+        done
+        cp -R "$here/corpus" "$1/$i/corpus"
+        i=$((i + 1))
+    done
+}
+
+# --file-jobs only splits files of FILE_SPLIT_MIN (4 MB) or more.
+mkdir -p "$work/split"
+i=0
+while [ $i -lt 160 ]; do
+    cat "$here/corpus/sub/deeper/gen.py" "$here/cases/nested_quotes/input.py"
+    i=$((i + 1))
+done > "$work/split/big.py"
+check_matches_serial "--file-jobs 4 on a $(wc -c < "$work/split/big.py")-byte file" "$work/split" "$bin" --file-jobs 4
+
+# -j takes files of SCHED_LARGE_MIN (256 KB) or more largest first and the others in
+# batches of up to 32, so the mixed tree has both kinds.
+mixed=$work/mixed
+copy_cases "$mixed" 8
+for copies in 12 40; do
+    i=0
+    while [ $i -lt $copies ]; do
+        cat "$here/corpus/sub/deeper/gen.py"
+        i=$((i + 1))
+    done > "$mixed/large-$copies.py"
+done
+check_matches_serial "-j 4 on $(find "$mixed" -name '*.py' | wc -l | tr -d ' ') files of mixed sizes" "$mixed" "$bin" -j 4
+
+# The io_uring loader is a build option, so it has its own binary. It is only built when
+# the suite builds the tool itself.
+if [ -z "${REFLOW_BIN:-}" ]; then
+    # shellcheck disable=SC2086
+    if $CC $CFLAGS -DREFLOW_IO_URING -o "$work/reformat_print_uring" "$root/reflow_comments.c"; then
+        check_matches_serial "-DREFLOW_IO_URING -j 4 on the mixed tree" "$mixed" "$work/reformat_print_uring" -j 4
+    else
+        fail "the -DREFLOW_IO_URING build failed"
+    fi
+fi
+
+# Performance: the cases and the corpus copied into a tree of a few hundred files, timed
+# with --check (nothing is written) and with the in-memory --bench corpus. bench_micro times
+# the wrappers and the comment gatherers on their own; it is built from the source tree.
+perf=$work/perf
+copy_cases "$perf" 40
+mkdir -p "$work/stats"
+# shellcheck disable=SC2086
+$CC $CFLAGS -o "$work/bench_micro" "$here/bench_micro.c" || fail "perf: bench_micro did not build"
+for run in 1 2 3 4 5; do
+    # --check exits with 1 when files would be reformatted, as they are here.
+    "$bin" --check --stats=json "$perf" > /dev/null 2> "$work/stats/run-$run.err"
+    status=$?
+    [ $status -le 1 ] || fail "perf: --check exited with status $status"
+    "$bin" --bench=files=200,black=0 > "$work/stats/bench-$run.out" 2>&1 || fail "perf: --bench failed"
+    "$work/bench_micro" > "$work/stats/micro-$run.out" || fail "perf: bench_micro failed"
+done
+if [ $update_baseline -eq 1 ]; then
+    python3 "$here/check_perf.py" "$here/perf-baseline.json" "$work/stats" --update || failures=$((failures + 1))
+else
+    python3 "$here/check_perf.py" "$here/perf-baseline.json" "$work/stats" || failures=$((failures + 1))
+fi
+
+if [ $failures -ne 0 ]; then
+    echo "$failures failure(s)"
+    exit 1
+fi
+echo "all tests passed"